@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "batch.hpp"
+#include "collision.hpp"
+
+//headless benchmark of the SAT kernels on seeded random boxes
+//usage : SAT-bench [--seed n] [--out file.json] [--min-time seconds]
+//the batch kernels are checked against each other and against sat::collides first,
+//the exit code is 2 if any result differs
+
+namespace
+{
+
+struct Result
+{
+    std::string kernel;
+    size_t boxes;
+    float density;
+    size_t pairs;
+    size_t collisions;
+    size_t iterations;
+    double nsPerOp;
+};
+
+//boxes with sides between 4 and 20 in a square world, density is the ratio of the
+//summed box areas to the area of the world
+std::vector<sf::RectangleShape> makeBoxes(size_t count, float density, unsigned seed)
+{
+    const float minSide = 4.0f;
+    const float maxSide = 20.0f;
+    const float meanArea = std::pow((minSide + maxSide) / 2.0f, 2.0f);
+    const float world = std::sqrt(count * meanArea / density);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<sf::RectangleShape> boxes(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        boxes[i].setSize({ minSide + (maxSide - minSide) * unit(rng), minSide + (maxSide - minSide) * unit(rng) });
+        boxes[i].setOrigin(boxes[i].getSize() / 2.0f);
+        boxes[i].setPosition(world * unit(rng), world * unit(rng));
+        boxes[i].setRotation(360.0f * unit(rng));
+    }
+    return boxes;
+}
+
+//runs f until minTime seconds are spent, and returns the time of one call in ns
+template <typename F>
+double measure(F f, double minTime, size_t& iterations)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    //warm up the caches and the broadphase order
+    f();
+
+    iterations = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0.0;
+    do
+    {
+        f();
+        ++iterations;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < minTime);
+
+    return elapsed * 1e9 / iterations;
+}
+
+//penetration of a and b as the batch kernels define it, the smallest of
+//ra + rb - |ca - cb| over the 4 axes, with the projections of sat::project
+float referenceDepth(const sf::RectangleShape& a, const sf::RectangleShape& b)
+{
+    const sf::RectangleShape* boxes[2] = { &a, &b };
+    float depth = 0.0f;
+    for (size_t n = 0; n < 4; ++n)
+    {
+        const sat::Axis axis = sat::calcNormal(*boxes[n / 2], n % 2);
+        const sat::ProjectedSegment pa = sat::project(a, axis);
+        const sat::ProjectedSegment pb = sat::project(b, axis);
+        const float overlap = pa.length() / 2.0f + pb.length() / 2.0f
+            - std::abs((pa.mini + pa.maxi) / 2.0f - (pb.mini + pb.maxi) / 2.0f);
+        depth = n == 0 ? overlap : std::min(depth, overlap);
+    }
+    return depth;
+}
+
+//compares testObbPairs to testObbPairsScalar bit for bit, and both to sat::collides
+//and referenceDepth. Those project the corners of the boxes, so they agree up to the
+//rounding of the coordinates, and pairs that barely touch may be classified either way
+size_t checkBatch(const std::vector<sf::RectangleShape>& boxes, const std::vector<sat::Pair>& pairs,
+    const sat::ObbArray& a, const sat::ObbArray& b)
+{
+    sat::BatchResult batch, scalar;
+    sat::testObbPairs(a, b, batch);
+    sat::testObbPairsScalar(a, b, scalar);
+
+    size_t mismatches = 0;
+    if (batch.hits != scalar.hits
+        || std::memcmp(batch.depth.data(), scalar.depth.data(), batch.depth.size() * sizeof(float)) != 0)
+    {
+        std::cerr << boxes.size() << " boxes : the " << sat::batchInstructionSet()
+            << " and scalar batch results differ" << std::endl;
+        ++mismatches;
+    }
+
+    size_t wrong = 0;
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        const sf::RectangleShape& boxA = boxes[pairs[i].a];
+        const sf::RectangleShape& boxB = boxes[pairs[i].b];
+        const float expected = referenceDepth(boxA, boxB);
+        const float scale = std::max(std::max(std::abs(a.x[i]), std::abs(a.y[i])), std::max(std::abs(b.x[i]), std::abs(b.y[i])));
+        const float tolerance = 1e-5f * (1.0f + scale);
+        const bool hit = batch.hit(i);
+        if (hit != sat::collides(boxA, boxB))
+        {
+            wrong += std::abs(expected) > tolerance;
+        }
+        else if (hit && std::abs(batch.depth[i] - expected) > tolerance)
+        {
+            ++wrong;
+        }
+    }
+    if (wrong != 0)
+    {
+        std::cerr << boxes.size() << " boxes : " << wrong << " pairs differ from sat::collides" << std::endl;
+    }
+    return mismatches + wrong;
+}
+
+void writeJson(std::ostream& out, unsigned seed, const std::vector<Result>& results)
+{
+    out << "{\n";
+    out << "  \"seed\": " << seed << ",\n";
+    out << "  \"instruction_set\": \"" << sat::batchInstructionSet() << "\",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& r = results[i];
+        out << "    {"
+            << "\"kernel\": \"" << r.kernel << "\", "
+            << "\"boxes\": " << r.boxes << ", "
+            << "\"density\": " << r.density << ", "
+            << "\"pairs\": " << r.pairs << ", "
+            << "\"collisions\": " << r.collisions << ", "
+            << "\"iterations\": " << r.iterations << ", "
+            << "\"ns_per_op\": " << r.nsPerOp << ", "
+            << "\"ops_per_sec\": " << (r.nsPerOp > 0.0 ? 1e9 / r.nsPerOp : 0.0)
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+} // !namespace
+
+int main(int argc, char** argv)
+{
+    unsigned seed = 1;
+    double minTime = 0.2;
+    std::string outFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            outFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+        {
+            minTime = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage : " << argv[0] << " [--seed n] [--out file.json] [--min-time seconds]" << std::endl;
+            return 1;
+        }
+    }
+
+    const size_t counts[] = { 1000, 5000, 20000 };
+    const float densities[] = { 0.05f, 0.2f, 0.5f };
+
+    std::vector<Result> results;
+    size_t mismatches = 0;
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+        for (size_t d = 0; d < sizeof(densities) / sizeof(densities[0]); ++d)
+        {
+            std::vector<sf::RectangleShape> boxes = makeBoxes(counts[c], densities[d], seed);
+
+            sat::SweepAndPrune broadphase;
+            std::vector<sat::Collision> collisions;
+            sat::findCollisions(boxes, broadphase, collisions);
+            const std::vector<sat::Pair> pairs = broadphase.getPairs();
+
+            Result r;
+            r.boxes = boxes.size();
+            r.density = densities[d];
+            r.pairs = pairs.size();
+            r.collisions = collisions.size();
+
+            //every box on the first normal of the next one
+            std::vector<sat::Axis> axes(boxes.size());
+            for (size_t i = 0; i < boxes.size(); ++i)
+            {
+                axes[i] = sat::calcNormal(boxes[(i + 1) % boxes.size()], 0);
+            }
+            volatile float projectSink = 0.0f;
+            r.kernel = "project";
+            r.nsPerOp = measure([&]
+            {
+                float sum = 0.0f;
+                for (size_t i = 0; i < boxes.size(); ++i)
+                {
+                    sum += sat::project(boxes[i], axes[i]).length();
+                }
+                projectSink = sum;
+            }, minTime, r.iterations) / boxes.size();
+            results.push_back(r);
+
+            if (pairs.empty())
+            {
+                continue;
+            }
+
+            volatile size_t collidesSink = 0;
+            r.kernel = "collides";
+            r.nsPerOp = measure([&]
+            {
+                size_t hits = 0;
+                for (size_t i = 0; i < pairs.size(); ++i)
+                {
+                    hits += sat::collides(boxes[pairs[i].a], boxes[pairs[i].b]);
+                }
+                collidesSink = hits;
+            }, minTime, r.iterations) / pairs.size();
+            results.push_back(r);
+
+            sat::ObbArray obbs, a, b;
+            obbs.resize(boxes.size());
+            for (size_t i = 0; i < boxes.size(); ++i)
+            {
+                obbs.set(i, boxes[i]);
+            }
+            sat::gatherPairs(obbs, pairs, a, b);
+            mismatches += checkBatch(boxes, pairs, a, b);
+
+            sat::BatchResult batch;
+            r.kernel = "batch";
+            r.nsPerOp = measure([&]
+            {
+                sat::gatherPairs(obbs, pairs, a, b);
+                sat::testObbPairs(a, b, batch);
+            }, minTime, r.iterations) / pairs.size();
+            results.push_back(r);
+
+            //broadphase and narrowphase, as run every frame
+            r.kernel = "find_collisions";
+            r.nsPerOp = measure([&]
+            {
+                sat::findCollisions(boxes, broadphase, collisions);
+            }, minTime, r.iterations) / pairs.size();
+            results.push_back(r);
+        }
+    }
+
+    if (outFile.empty())
+    {
+        writeJson(std::cout, seed, results);
+    }
+    else
+    {
+        std::ofstream out(outFile.c_str());
+        if (!out)
+        {
+            std::cerr << "can not write " << outFile << std::endl;
+            return 1;
+        }
+        writeJson(out, seed, results);
+    }
+
+    return mismatches == 0 ? 0 : 2;
+}
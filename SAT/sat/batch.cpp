@@ -0,0 +1,225 @@
+#include "batch.hpp"
+
+#include <cmath>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SAT_BATCH_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace sat
+{
+
+namespace
+{
+
+const double PI = 3.14159265359;
+
+//the separation test for a single pair, every vector path below does the exact
+//same operations in the same order so the results match bit for bit
+inline bool testPair(const ObbArray& a, const ObbArray& b, size_t i, float& depth)
+{
+    float dx = b.x[i] - a.x[i];
+    float dy = b.y[i] - a.y[i];
+
+    //|dot| between the axes of both boxes
+    float r = std::abs(a.c[i] * b.c[i] + a.s[i] * b.s[i]);
+    float q = std::abs(a.s[i] * b.c[i] - a.c[i] * b.s[i]);
+
+    float o0 = a.hx[i] + (b.hx[i] * r + b.hy[i] * q) - std::abs(dx * a.c[i] + dy * a.s[i]);
+    float o1 = a.hy[i] + (b.hx[i] * q + b.hy[i] * r) - std::abs(dy * a.c[i] - dx * a.s[i]);
+    float o2 = (a.hx[i] * r + a.hy[i] * q) + b.hx[i] - std::abs(dx * b.c[i] + dy * b.s[i]);
+    float o3 = (a.hx[i] * q + a.hy[i] * r) + b.hy[i] - std::abs(dy * b.c[i] - dx * b.s[i]);
+
+    float m01 = o0 < o1 ? o0 : o1;
+    float m23 = o2 < o3 ? o2 : o3;
+    float m = m01 < m23 ? m01 : m23;
+
+    bool hit = m > 0.0f;
+    depth = hit ? m : 0.0f;
+    return hit;
+}
+
+void prepareResult(size_t n, BatchResult& result)
+{
+    result.hits.assign((n + 31) / 32, 0u);
+    result.depth.resize(n);
+}
+
+void testRangeScalar(const ObbArray& a, const ObbArray& b, size_t begin, size_t end, BatchResult& result)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (testPair(a, b, i, result.depth[i]))
+        {
+            result.hits[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
+
+} // !namespace
+
+void ObbArray::resize(size_t n)
+{
+    x.resize(n);
+    y.resize(n);
+    hx.resize(n);
+    hy.resize(n);
+    c.resize(n);
+    s.resize(n);
+}
+
+void ObbArray::set(size_t i, const sf::RectangleShape& box)
+{
+    sf::Vector2f half = box.getSize() / 2.0f;
+    sf::Vector2f center = box.getTransform().transformPoint(half);
+    float angle = static_cast<float>(box.getRotation() * PI / 180.0);
+
+    x[i] = center.x;
+    y[i] = center.y;
+    hx[i] = std::abs(half.x * box.getScale().x);
+    hy[i] = std::abs(half.y * box.getScale().y);
+    c[i] = std::cos(angle);
+    s[i] = std::sin(angle);
+}
+
+void gatherPairs(const ObbArray& boxes, const std::vector<Pair>& pairs, ObbArray& a, ObbArray& b)
+{
+    a.resize(pairs.size());
+    b.resize(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        size_t ia = pairs[i].a, ib = pairs[i].b;
+        a.x[i] = boxes.x[ia]; a.y[i] = boxes.y[ia];
+        a.hx[i] = boxes.hx[ia]; a.hy[i] = boxes.hy[ia];
+        a.c[i] = boxes.c[ia]; a.s[i] = boxes.s[ia];
+
+        b.x[i] = boxes.x[ib]; b.y[i] = boxes.y[ib];
+        b.hx[i] = boxes.hx[ib]; b.hy[i] = boxes.hy[ib];
+        b.c[i] = boxes.c[ib]; b.s[i] = boxes.s[ib];
+    }
+}
+
+void testObbPairsScalar(const ObbArray& a, const ObbArray& b, BatchResult& result)
+{
+    prepareResult(a.size(), result);
+    testRangeScalar(a, b, 0, a.size(), result);
+}
+
+#if defined(__AVX__)
+
+void testObbPairs(const ObbArray& a, const ObbArray& b, BatchResult& result)
+{
+    const size_t n = a.size();
+    prepareResult(n, result);
+
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 ax = _mm256_loadu_ps(&a.x[i]), ay = _mm256_loadu_ps(&a.y[i]);
+        __m256 ahx = _mm256_loadu_ps(&a.hx[i]), ahy = _mm256_loadu_ps(&a.hy[i]);
+        __m256 ac = _mm256_loadu_ps(&a.c[i]), as = _mm256_loadu_ps(&a.s[i]);
+        __m256 bx = _mm256_loadu_ps(&b.x[i]), by = _mm256_loadu_ps(&b.y[i]);
+        __m256 bhx = _mm256_loadu_ps(&b.hx[i]), bhy = _mm256_loadu_ps(&b.hy[i]);
+        __m256 bc = _mm256_loadu_ps(&b.c[i]), bs = _mm256_loadu_ps(&b.s[i]);
+
+        __m256 dx = _mm256_sub_ps(bx, ax);
+        __m256 dy = _mm256_sub_ps(by, ay);
+
+        __m256 r = _mm256_andnot_ps(signMask, _mm256_add_ps(_mm256_mul_ps(ac, bc), _mm256_mul_ps(as, bs)));
+        __m256 q = _mm256_andnot_ps(signMask, _mm256_sub_ps(_mm256_mul_ps(as, bc), _mm256_mul_ps(ac, bs)));
+
+        __m256 p0 = _mm256_andnot_ps(signMask, _mm256_add_ps(_mm256_mul_ps(dx, ac), _mm256_mul_ps(dy, as)));
+        __m256 p1 = _mm256_andnot_ps(signMask, _mm256_sub_ps(_mm256_mul_ps(dy, ac), _mm256_mul_ps(dx, as)));
+        __m256 p2 = _mm256_andnot_ps(signMask, _mm256_add_ps(_mm256_mul_ps(dx, bc), _mm256_mul_ps(dy, bs)));
+        __m256 p3 = _mm256_andnot_ps(signMask, _mm256_sub_ps(_mm256_mul_ps(dy, bc), _mm256_mul_ps(dx, bs)));
+
+        __m256 o0 = _mm256_sub_ps(_mm256_add_ps(ahx, _mm256_add_ps(_mm256_mul_ps(bhx, r), _mm256_mul_ps(bhy, q))), p0);
+        __m256 o1 = _mm256_sub_ps(_mm256_add_ps(ahy, _mm256_add_ps(_mm256_mul_ps(bhx, q), _mm256_mul_ps(bhy, r))), p1);
+        __m256 o2 = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ahx, r), _mm256_mul_ps(ahy, q)), bhx), p2);
+        __m256 o3 = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ahx, q), _mm256_mul_ps(ahy, r)), bhy), p3);
+
+        __m256 m = _mm256_min_ps(_mm256_min_ps(o0, o1), _mm256_min_ps(o2, o3));
+        __m256 hit = _mm256_cmp_ps(m, zero, _CMP_GT_OQ);
+
+        _mm256_storeu_ps(&result.depth[i], _mm256_and_ps(hit, m));
+        result.hits[i / 32] |= static_cast<uint32_t>(_mm256_movemask_ps(hit)) << (i % 32);
+    }
+
+    testRangeScalar(a, b, i, n, result);
+}
+
+#elif defined(SAT_BATCH_SSE2)
+
+void testObbPairs(const ObbArray& a, const ObbArray& b, BatchResult& result)
+{
+    const size_t n = a.size();
+    prepareResult(n, result);
+
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 ax = _mm_loadu_ps(&a.x[i]), ay = _mm_loadu_ps(&a.y[i]);
+        __m128 ahx = _mm_loadu_ps(&a.hx[i]), ahy = _mm_loadu_ps(&a.hy[i]);
+        __m128 ac = _mm_loadu_ps(&a.c[i]), as = _mm_loadu_ps(&a.s[i]);
+        __m128 bx = _mm_loadu_ps(&b.x[i]), by = _mm_loadu_ps(&b.y[i]);
+        __m128 bhx = _mm_loadu_ps(&b.hx[i]), bhy = _mm_loadu_ps(&b.hy[i]);
+        __m128 bc = _mm_loadu_ps(&b.c[i]), bs = _mm_loadu_ps(&b.s[i]);
+
+        __m128 dx = _mm_sub_ps(bx, ax);
+        __m128 dy = _mm_sub_ps(by, ay);
+
+        __m128 r = _mm_andnot_ps(signMask, _mm_add_ps(_mm_mul_ps(ac, bc), _mm_mul_ps(as, bs)));
+        __m128 q = _mm_andnot_ps(signMask, _mm_sub_ps(_mm_mul_ps(as, bc), _mm_mul_ps(ac, bs)));
+
+        __m128 p0 = _mm_andnot_ps(signMask, _mm_add_ps(_mm_mul_ps(dx, ac), _mm_mul_ps(dy, as)));
+        __m128 p1 = _mm_andnot_ps(signMask, _mm_sub_ps(_mm_mul_ps(dy, ac), _mm_mul_ps(dx, as)));
+        __m128 p2 = _mm_andnot_ps(signMask, _mm_add_ps(_mm_mul_ps(dx, bc), _mm_mul_ps(dy, bs)));
+        __m128 p3 = _mm_andnot_ps(signMask, _mm_sub_ps(_mm_mul_ps(dy, bc), _mm_mul_ps(dx, bs)));
+
+        __m128 o0 = _mm_sub_ps(_mm_add_ps(ahx, _mm_add_ps(_mm_mul_ps(bhx, r), _mm_mul_ps(bhy, q))), p0);
+        __m128 o1 = _mm_sub_ps(_mm_add_ps(ahy, _mm_add_ps(_mm_mul_ps(bhx, q), _mm_mul_ps(bhy, r))), p1);
+        __m128 o2 = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ahx, r), _mm_mul_ps(ahy, q)), bhx), p2);
+        __m128 o3 = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ahx, q), _mm_mul_ps(ahy, r)), bhy), p3);
+
+        __m128 m = _mm_min_ps(_mm_min_ps(o0, o1), _mm_min_ps(o2, o3));
+        __m128 hit = _mm_cmpgt_ps(m, zero);
+
+        _mm_storeu_ps(&result.depth[i], _mm_and_ps(hit, m));
+        result.hits[i / 32] |= static_cast<uint32_t>(_mm_movemask_ps(hit)) << (i % 32);
+    }
+
+    testRangeScalar(a, b, i, n, result);
+}
+
+#else
+
+void testObbPairs(const ObbArray& a, const ObbArray& b, BatchResult& result)
+{
+    testObbPairsScalar(a, b, result);
+}
+
+#endif
+
+const char* batchInstructionSet()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__AVX__)
+    return "AVX";
+#elif defined(SAT_BATCH_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+} // !namespace sat
@@ -0,0 +1,66 @@
+#ifndef SAT_BATCH_HPP
+#define SAT_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "broadphase.hpp"
+
+namespace sat
+{
+
+//oriented boxes stored as a structure of arrays
+//x,y is the center, hx,hy the half extents and c,s the cosine and sine of the rotation
+struct ObbArray
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> hx;
+    std::vector<float> hy;
+    std::vector<float> c;
+    std::vector<float> s;
+
+    void resize(size_t n);
+
+    size_t size() const
+    {
+        return x.size();
+    }
+
+    //the origin of box does not need to be its center
+    void set(size_t i, const sf::RectangleShape& box);
+};
+
+struct BatchResult
+{
+    //bit (i % 32) of hits[i / 32] is set if pair i collides
+    std::vector<uint32_t> hits;
+    //penetration along the axis of least penetration, 0 if the pair is separated
+    std::vector<float> depth;
+
+    bool hit(size_t i) const
+    {
+        return (hits[i / 32] >> (i % 32)) & 1u;
+    }
+};
+
+//packs the boxes of each pair so that a[i] is tested against b[i]
+void gatherPairs(const ObbArray& boxes, const std::vector<Pair>& pairs, ObbArray& a, ObbArray& b);
+
+//tests a[i] against b[i] on the 4 axes of the two boxes
+//touching boxes are not considered colliding, like sat::collides
+void testObbPairsScalar(const ObbArray& a, const ObbArray& b, BatchResult& result);
+
+//same as testObbPairsScalar, 8 pairs at a time with AVX2 or 4 with SSE2
+//depending on what the library was compiled for. The results are bitwise identical
+void testObbPairs(const ObbArray& a, const ObbArray& b, BatchResult& result);
+
+//name of the instruction set used by testObbPairs
+const char* batchInstructionSet();
+
+} // !namespace sat
+
+#endif // SAT_BATCH_HPP
@@ -0,0 +1,66 @@
+#include "broadphase.hpp"
+
+#include <algorithm>
+
+namespace sat
+{
+
+void SweepAndPrune::update(const std::vector<sf::FloatRect>& bounds)
+{
+    //the number of objects changed, start over from an unsorted list
+    if (_entries.size() != bounds.size())
+    {
+        _entries.resize(bounds.size());
+        for (size_t i = 0; i < _entries.size(); ++i)
+        {
+            _entries[i].index = i;
+        }
+    }
+
+    for (size_t i = 0; i < _entries.size(); ++i)
+    {
+        const sf::FloatRect& r = bounds[_entries[i].index];
+        _entries[i].left = r.left;
+        _entries[i].right = r.left + r.width;
+        _entries[i].top = r.top;
+        _entries[i].bottom = r.top + r.height;
+    }
+
+    //insertion sort, close to O(n) since the previous order is almost right
+    for (size_t i = 1; i < _entries.size(); ++i)
+    {
+        Entry e = _entries[i];
+        size_t j = i;
+        while (j > 0 && _entries[j - 1].left > e.left)
+        {
+            _entries[j] = _entries[j - 1];
+            --j;
+        }
+        _entries[j] = e;
+    }
+
+    _pairs.clear();
+    for (size_t i = 0; i < _entries.size(); ++i)
+    {
+        const Entry& e = _entries[i];
+        for (size_t j = i + 1; j < _entries.size() && _entries[j].left <= e.right; ++j)
+        {
+            const Entry& o = _entries[j];
+            if (o.top > e.bottom || e.top > o.bottom)
+            {
+                continue;
+            }
+            Pair p;
+            p.a = std::min(e.index, o.index);
+            p.b = std::max(e.index, o.index);
+            _pairs.push_back(p);
+        }
+    }
+
+    std::sort(_pairs.begin(), _pairs.end(), [](const Pair& l, const Pair& r)
+    {
+        return l.a < r.a || (l.a == r.a && l.b < r.b);
+    });
+}
+
+} // !namespace sat
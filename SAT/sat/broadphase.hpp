@@ -0,0 +1,52 @@
+#ifndef SAT_BROADPHASE_HPP
+#define SAT_BROADPHASE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace sat
+{
+
+//two indices into the bounds given to the broadphase, a < b
+struct Pair
+{
+    size_t a;
+    size_t b;
+};
+
+//sort and sweep broadphase on the x axis
+//the sorted order is kept between updates so that an insertion sort
+//only has a few swaps to do when the objects move a little
+class SweepAndPrune
+{
+    public:
+
+        //recomputes the list of pairs whose bounds overlap
+        void update(const std::vector<sf::FloatRect>& bounds);
+
+        //pairs are sorted by (a, b) so the result does not depend on the sort order
+        const std::vector<Pair>& getPairs() const
+        {
+            return _pairs;
+        }
+
+    private:
+
+        struct Entry
+        {
+            float left;
+            float right;
+            float top;
+            float bottom;
+            size_t index;
+        };
+
+        std::vector<Entry> _entries;
+        std::vector<Pair> _pairs;
+};
+
+} // !namespace sat
+
+#endif // SAT_BROADPHASE_HPP
@@ -0,0 +1,166 @@
+#include "collision.hpp"
+
+#include <algorithm>
+
+namespace sat
+{
+
+namespace
+{
+
+sf::FloatRect getBounds(const sf::RectangleShape& box)
+{
+    return box.getGlobalBounds();
+}
+
+sf::FloatRect getBounds(const ShapeCache& shape)
+{
+    return shape.getBounds();
+}
+
+template <typename Shape>
+void updateBroadphase(const std::vector<Shape>& shapes, SweepAndPrune& broadphase)
+{
+    std::vector<sf::FloatRect> bounds(shapes.size());
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+        bounds[i] = getBounds(shapes[i]);
+    }
+    broadphase.update(bounds);
+}
+
+template <typename Shape>
+void findCachedCollisions(const std::vector<Shape>& shapes, SweepAndPrune& broadphase, PairCache& cache, std::vector<Collision>& collisions)
+{
+    updateBroadphase(shapes, broadphase);
+    cache.newFrame();
+
+    collisions.clear();
+    const std::vector<Pair>& pairs = broadphase.getPairs();
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        Collision c;
+        c.a = pairs[i].a;
+        c.b = pairs[i].b;
+        if (cache.collides(c.a, shapes[c.a], c.b, shapes[c.b], &c.overlap))
+        {
+            collisions.push_back(c);
+        }
+    }
+}
+
+} // !namespace
+
+void findCollisions(const std::vector<sf::RectangleShape>& boxes, SweepAndPrune& broadphase, std::vector<Collision>& collisions)
+{
+    updateBroadphase(boxes, broadphase);
+
+    collisions.clear();
+    const std::vector<Pair>& pairs = broadphase.getPairs();
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        Collision c;
+        c.a = pairs[i].a;
+        c.b = pairs[i].b;
+        if (collides(boxes[c.a], boxes[c.b], &c.overlap))
+        {
+            collisions.push_back(c);
+        }
+    }
+}
+
+void findCollisions(const std::vector<sf::RectangleShape>& boxes, SweepAndPrune& broadphase, PairCache& cache, std::vector<Collision>& collisions)
+{
+    findCachedCollisions(boxes, broadphase, cache, collisions);
+}
+
+void findCollisions(const std::vector<ShapeCache>& shapes, SweepAndPrune& broadphase, PairCache& cache, std::vector<Collision>& collisions)
+{
+    findCachedCollisions(shapes, broadphase, cache, collisions);
+}
+
+void findCollisions(const std::vector<ShapeCache>& shapes, SweepAndPrune& broadphase, ThreadPool& pool, std::vector<Collision>& collisions)
+{
+    updateBroadphase(shapes, broadphase);
+
+    //each thread fills its own buffer, so nothing is shared while testing
+    const std::vector<Pair>& pairs = broadphase.getPairs();
+    std::vector<std::vector<Collision>> buffers(pool.size());
+    pool.parallelFor(pairs.size(), 256, [&](size_t begin, size_t end, size_t thread)
+    {
+        std::vector<Collision>& buffer = buffers[thread];
+        for (size_t i = begin; i < end; ++i)
+        {
+            Collision c;
+            c.a = pairs[i].a;
+            c.b = pairs[i].b;
+            if (collides(shapes[c.a], shapes[c.b], &c.overlap))
+            {
+                buffer.push_back(c);
+            }
+        }
+    });
+
+    //the chunks run by a thread depend on the stealing, sorting the merged buffers
+    //gives back the order of the pairs, the same as the single threaded version
+    collisions.clear();
+    for (size_t t = 0; t < buffers.size(); ++t)
+    {
+        collisions.insert(collisions.end(), buffers[t].begin(), buffers[t].end());
+    }
+    std::sort(collisions.begin(), collisions.end(), [](const Collision& l, const Collision& r)
+    {
+        return l.a < r.a || (l.a == r.a && l.b < r.b);
+    });
+}
+
+void findContacts(const std::vector<ShapeCache>& shapes, SweepAndPrune& broadphase, PairCache& cache, std::vector<Contact>& contacts)
+{
+    updateBroadphase(shapes, broadphase);
+    cache.newFrame();
+
+    contacts.clear();
+    const std::vector<Pair>& pairs = broadphase.getPairs();
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        Contact c;
+        c.a = pairs[i].a;
+        c.b = pairs[i].b;
+        if (cache.collide(c.a, shapes[c.a], c.b, shapes[c.b], c.manifold))
+        {
+            contacts.push_back(c);
+        }
+    }
+}
+
+void findImpacts(const std::vector<ShapeCache>& shapes, const std::vector<sf::Vector2f>& displacements, SweepAndPrune& broadphase, std::vector<Impact>& impacts)
+{
+    std::vector<sf::FloatRect> bounds(shapes.size());
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+        const sf::FloatRect& r = shapes[i].getBounds();
+        const sf::Vector2f& d = displacements[i];
+        bounds[i] = sf::FloatRect(r.left + std::min(d.x, 0.0f), r.top + std::min(d.y, 0.0f), r.width + std::abs(d.x), r.height + std::abs(d.y));
+    }
+    broadphase.update(bounds);
+
+    impacts.clear();
+    const std::vector<Pair>& pairs = broadphase.getPairs();
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        Impact c;
+        c.a = pairs[i].a;
+        c.b = pairs[i].b;
+        //shapes moving together can not start touching
+        if (displacements[c.a] == displacements[c.b])
+        {
+            continue;
+        }
+        if (sweep(shapes[c.a], displacements[c.a], shapes[c.b], displacements[c.b], c.toi) && c.toi.first >= 0.0f)
+        {
+            impacts.push_back(c);
+        }
+    }
+}
+
+} // !namespace sat
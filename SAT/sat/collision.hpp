@@ -0,0 +1,63 @@
+#ifndef SAT_COLLISION_HPP
+#define SAT_COLLISION_HPP
+
+#include <vector>
+
+#include "sat.hpp"
+#include "broadphase.hpp"
+#include "paircache.hpp"
+#include "shapecache.hpp"
+#include "manifold.hpp"
+#include "sweep.hpp"
+#include "threadpool.hpp"
+
+namespace sat
+{
+
+struct Collision
+{
+    size_t a;
+    size_t b;
+    ProjectedSegment overlap;
+};
+
+struct Contact
+{
+    size_t a;
+    size_t b;
+    Manifold manifold;
+};
+
+struct Impact
+{
+    size_t a;
+    size_t b;
+    TimeOfImpact toi;
+};
+
+//runs the broadphase over the bounds of the boxes, then the SAT test on every
+//candidate pair. collisions is cleared and filled in the order of the pairs
+void findCollisions(const std::vector<sf::RectangleShape>& boxes, SweepAndPrune& broadphase, std::vector<Collision>& collisions);
+
+//same as above, but the narrowphase starts with the axis that separated each pair last frame
+void findCollisions(const std::vector<sf::RectangleShape>& boxes, SweepAndPrune& broadphase, PairCache& cache, std::vector<Collision>& collisions);
+
+//same as above on cached shapes, call ShapeCache::update on the moved shapes first
+void findCollisions(const std::vector<ShapeCache>& shapes, SweepAndPrune& broadphase, PairCache& cache, std::vector<Collision>& collisions);
+
+//same as above, with the candidate pairs split between the threads of pool
+//the result does not depend on the number of threads
+void findCollisions(const std::vector<ShapeCache>& shapes, SweepAndPrune& broadphase, ThreadPool& pool, std::vector<Collision>& collisions);
+
+//same as findCollisions, but computes the full contact manifold of every colliding pair
+void findContacts(const std::vector<ShapeCache>& shapes, SweepAndPrune& broadphase, PairCache& cache, std::vector<Contact>& contacts);
+
+//continuous test for shapes moved by displacements during the frame. The broadphase
+//runs on the bounds swept by the shapes, and only the pairs that are separated at
+//the start of the frame and touch before its end are kept in impacts
+//overlapping pairs are left to findCollisions or findContacts
+void findImpacts(const std::vector<ShapeCache>& shapes, const std::vector<sf::Vector2f>& displacements, SweepAndPrune& broadphase, std::vector<Impact>& impacts);
+
+} // !namespace sat
+
+#endif // SAT_COLLISION_HPP
@@ -1,9 +1,18 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <random>
 #include <sstream>
-#include <array>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <SFML/Graphics.hpp>
 
+#include "collision.hpp"
+#include "profiler.hpp"
+
 #define WIDTH   640
 #define HEIGHT  480
 
@@ -35,250 +44,103 @@ float getAngleBetweenVectors(const sf::Vector2<T>& o, const sf::Vector2<T>& v) {
     return (float)-(atan2(static_cast<double>(o.y), static_cast<double>(o.x)) - atan2(static_cast<double>(v.y), static_cast<double>(v.x)));
 }
 
-template <typename T>
-float norm2(const sf::Vector2<T>& a)
-{
-    return static_cast<float>(a.x*a.x + a.y*a.y);
-}
-
-template <typename T>
-float norm(const sf::Vector2<T>& a)
-{
-    return sqrt(norm2(a));
-}
-
-template <typename T>
-sf::Vector2<T> normalize(const sf::Vector2<T>& vec)
-{
-    T n = norm(vec);
-    return sf::Vector2<T>(T(vec.x / n), T(vec.y / n));
-}
-
-template <typename T>
-T dot(const sf::Vector2<T>& a, const sf::Vector2<T>& b) {
-    return a.x*b.x + a.y*b.y;
-}
-
-class Axis : public sf::Drawable
-{
-    public:
-
-        Axis(const sf::Vector2f& o = { 0, 0 }, const sf::Vector2f& d = { 0, 0 }, const sf::Color& c = sf::Color::Black)
-        {
-            origin = o;
-            direction = d;
-            color = c;
-        }
-
-        bool operator!=(const Axis& o) const
-        {
-            return origin != o.origin || direction != o.direction;
-        }
-
-        sf::Vector2f origin;
-        sf::Vector2f direction;
-        sf::Color color;
-
-    protected:
-        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
-};
-
-class Segment : public sf::Drawable
-{
-    public:
-        std::array<sf::Vector2f,2> points;
-        sf::Color color;
-
-        Segment(const Axis& a) : Segment(a.origin, a.origin + a.direction, a.color)
-        {
-        }
-
-        Segment(const sf::Vector2f& a = { 0, 0 }, const sf::Vector2f& b = { 0, 0 }, const sf::Color& c = sf::Color::Black)
-        {
-            points[0] = a;
-            points[1] = b;
-            color = c;
-        }
-
-        Axis getNormal()
-        {
-            sf::Vector2f d = points[1] - points[0];
-            Axis a;
-            a.origin = points[0] + d / 2.0f;
-            a.direction = normalize(sf::Vector2f(d.y, -d.x));
-            a.color = color;
-            return a;
-        }
-
-        sf::Vector2f getDirection()
-        {
-            return points[1] - points[0];
-        }
-
-        float norm()
-        {
-            return ::norm(points[1] - points[0]);
-        }
-
-    protected:
-        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
-};
-
-class ProjectedSegment
-{
-    public:
-        ProjectedSegment(const Axis& a = Axis(), float mn = 0.0f, float mx = 0.0f, const sf::Color& c = sf::Color::Black)
-        {
-            axis = a;
-            mini = mn;
-            maxi = mx;
-            color = c;
-        }
-
-        operator Segment() const
-        {
-            return Segment(axis.origin + mini * axis.direction, axis.origin + maxi * axis.direction, color);
-        }
-
-        ProjectedSegment collides(const ProjectedSegment& other)
-        {
-
-            float x1 = 0.0, x2 = 0.0f;
-            if (other.axis != axis || mini > other.maxi || other.mini > maxi)
-            {
-                return ProjectedSegment();
-            }
-            /*std::cout << "Axis : " << axis.origin << " > " << axis.direction << std::endl;
-            std::cout << "min/max : " << mini << ">" << maxi
-                << " ; "
-                << other.mini << ">" << other.maxi
-                << std::endl;*/
-
-            x1 = std::max(mini, other.mini);
-            x2 = std::min(maxi, other.maxi);
-
-            /*std::cout << "Projection : " << x1 << ">" << x2 << std::endl;
-            std::cout << " " << std::endl;*/
-
-            return ProjectedSegment(axis, x1, x2, sf::Color::White);
-        }
-
-        float length() const
-        {
-            return std::abs(maxi - mini);
-        }
-
-        Axis axis;
-        float mini;
-        float maxi;
-        sf::Color color;
-
-    protected:
-};
-
-void calcNormals(std::array<sf::RectangleShape, 2>& boxes, std::array<Axis, 4>& normals)
+bool sameCollisions(const std::vector<sat::Collision>& a, const std::vector<sat::Collision>& b)
 {
-    int colorReduction = 3;
+    if (a.size() != b.size())
     {
-        sf::Transform t = boxes[0].getTransform();
-        {
-            Segment s(t.transformPoint(boxes[0].getPoint(0)), t.transformPoint(boxes[0].getPoint(1)), boxes[0].getFillColor());
-            s.color.r /= colorReduction;
-            s.color.g /= colorReduction;
-            s.color.b /= colorReduction;
-            normals[0] = s.getNormal();
-            //normals[0].origin -= s.getDirection();
-        }
-        {
-            Segment s(t.transformPoint(boxes[0].getPoint(1)), t.transformPoint(boxes[0].getPoint(2)), boxes[0].getFillColor());
-            s.color.r /= colorReduction;
-            s.color.g /= colorReduction;
-            s.color.b /= colorReduction;
-            normals[1] = s.getNormal();
-            //normals[1].origin -= s.getDirection();
-        }
+        return false;
     }
-
+    for (size_t i = 0; i < a.size(); ++i)
     {
-        sf::Transform t = boxes[1].getTransform();
+        if (a[i].a != b[i].a || a[i].b != b[i].b
+            || a[i].overlap.mini != b[i].overlap.mini || a[i].overlap.maxi != b[i].overlap.maxi)
         {
-            Segment s(t.transformPoint(boxes[1].getPoint(0)), t.transformPoint(boxes[1].getPoint(1)), boxes[1].getFillColor());
-            s.color.r /= colorReduction;
-            s.color.g /= colorReduction;
-            s.color.b /= colorReduction;
-            normals[2] = s.getNormal();
-            //normals[2].origin += s.getDirection();
-        }
-        {
-            Segment s(t.transformPoint(boxes[1].getPoint(1)), t.transformPoint(boxes[1].getPoint(2)), boxes[1].getFillColor());
-            s.color.r /= colorReduction;
-            s.color.g /= colorReduction;
-            s.color.b /= colorReduction;
-            normals[3] = s.getNormal();
-            //normals[3].origin += s.getDirection();
+            return false;
         }
     }
+    return true;
 }
 
-//returns distance from axis center to point
-float project(const sf::Vector2f& v, const Axis& axis)
+//times the threaded collision stage on a crowded scene from 1 thread to the
+//number of hardware threads, and checks every run finds the same collisions
+int runScaling()
 {
-    return dot(v-axis.origin, axis.direction);
-}
+    const size_t count = 20000;
+    const int frames = 20;
 
-ProjectedSegment project(const sf::RectangleShape& box, const Axis& axis)
-{
-    //std::cout << "Axis : " << axis.origin << ">" << axis.direction << std::endl;
-    const sf::Transform& t = box.getTransform();
-    std::array<float, 4> projections;
-    for (size_t i = 0; i < 4; ++i)
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<sf::RectangleShape> boxes(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        projections[i] = project(t.transformPoint(box.getPoint(i)), axis);
-        //std::cout << "projections[" << t.transformPoint(box.getPoint(i)) << "] = " << projections[i] << std::endl;
+        boxes[i].setSize({ 4.0f + 16.0f * unit(rng), 4.0f + 16.0f * unit(rng) });
+        boxes[i].setOrigin(boxes[i].getSize() / 2.0f);
+        boxes[i].setPosition(2000.0f * unit(rng), 2000.0f * unit(rng));
+        boxes[i].setRotation(360.0f * unit(rng));
+    }
+
+    std::vector<sat::ShapeCache> shapes;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        shapes.push_back(sat::ShapeCache(boxes[i]));
     }
 
-    float mini = projections[0], maxi = projections[0];
-    for (size_t i = 1; i < 4; ++i)
+    std::vector<sat::Collision> reference;
+    double referenceTime = 0.0;
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; ++threads)
     {
-        if (projections[i] < mini)
+        sat::ThreadPool pool(threads);
+        sat::SweepAndPrune broadphase;
+        std::vector<sat::Collision> collisions;
+
+        //the first frame fills the broadphase, it is not timed
+        sat::findCollisions(shapes, broadphase, pool, collisions);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; ++f)
         {
-            mini = projections[i];
+            sat::findCollisions(shapes, broadphase, pool, collisions);
         }
-        else if(projections[i] > maxi)
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+        if (threads == 1)
         {
-            maxi = projections[i];
+            reference = collisions;
+            referenceTime = ms;
         }
+        std::cout << threads << " threads : " << ms << " ms/frame, speedup " << referenceTime / ms
+            << ", " << collisions.size() << " collisions" << (sameCollisions(reference, collisions) ? "" : " MISMATCH") << std::endl;
     }
 
-    //std::cout << "***********" << std::endl;
-    /*std::cout << "Projection of box " 
-        << box.getPoint(0) << ">" << box.getPoint(1) 
-        << "on axis " << axis.origin << " > " << axis.direction
-        << " = " << mini << ">" << maxi         
-        << std::endl;*/
-
-    return ProjectedSegment(axis, mini, maxi, sf::Color::White);
+    return 0;
 }
 
-void calcProjections(std::array<ProjectedSegment, 8>& projections, std::array<sf::RectangleShape, 2>& boxes, std::array<Axis, 4>& normals)
+//usage : SAT [--scaling] [--profile file.csv]
+//--scaling times the threaded collision stage and exits
+//--profile file.csv writes the time of every stage of every frame to a CSV file
+//F10 shows the profiler, F11 writes its last frames to profile.csv
+int main(int argc, char** argv)
 {
-    for (size_t b = 0; b < boxes.size(); ++b)
+    std::string profileFile;
+    for (int i = 1; i < argc; ++i)
     {
-        for (size_t n = 0; n < normals.size(); ++n)
+        if (std::strcmp(argv[i], "--scaling") == 0)
         {
-            projections[b * 4 + n] = project(boxes[b], normals[n]);
-            projections[b * 4 + n].color = boxes[b].getFillColor() + sf::Color(50, 50, 50);;
+            return runScaling();
+        }
+        else if (!sandbox::parseProfileArgument(argc, argv, i, profileFile))
+        {
+            std::cerr << "usage : " << argv[0] << " [--scaling] [--profile file.csv]" << std::endl;
+            return 1;
         }
     }
-}
 
-int main(int argc, char** argv)
-{
     /** SFML STUFF **/
 
     sf::RenderWindow window(sf::VideoMode(WIDTH, HEIGHT), "SAT test");
 
-    std::array<sf::RectangleShape, 2> boxes;
+    std::vector<sf::RectangleShape> boxes(2);
     boxes[0].setFillColor(sf::Color::Blue);
     boxes[0].setPosition(150, 150);
     boxes[0].setSize({ 150, 50 });
@@ -301,14 +163,27 @@ int main(int argc, char** argv)
     sf::Vector2f xVector(1.0f, 0.0f);
 
     //SAT related stuff
-    std::array<Axis, 4> normals;
-    std::array<ProjectedSegment, 8> projections;
-    std::array<ProjectedSegment, 4> collisions;
+    sat::SweepAndPrune broadphase;
+    sat::PairCache pairCache;
+    std::vector<sat::Contact> contacts;
+
+    std::vector<sat::ShapeCache> shapes;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        shapes.push_back(sat::ShapeCache(boxes[i]));
+    }
+
+    sat::findContacts(shapes, broadphase, pairCache, contacts);
 
-    calcNormals(boxes, normals);
-    calcProjections(projections, boxes, normals);
-    ProjectedSegment collisionVector;
-    collisionVector.color = sf::Color::Black;
+    sandbox::Profiler profiler;
+    const size_t eventStage = profiler.addStage("events", sf::Color(170, 170, 170));
+    const size_t contactStage = profiler.addStage("contacts", sf::Color(220, 50, 50));
+    const size_t drawStage = profiler.addStage("draw", sf::Color(70, 130, 230));
+    sandbox::ProfilerOverlay overlay(profiler, sf::FloatRect(20.0f, 20.0f, 240.0f, 80.0f));
+    if (!profiler.startStream(profileFile))
+    {
+        return 1;
+    }
 
     sf::Clock fpsTest;
     size_t frames = 0;
@@ -316,6 +191,10 @@ int main(int argc, char** argv)
     //the loop
     while (window.isOpen())
     {
+        //the contacts are found once per frame, after every move of the frame
+        bool moved = false;
+
+        sandbox::ScopedStage eventTime(profiler, eventStage);
         sf::Event event;
         while (window.pollEvent(event)) 
         {
@@ -325,12 +204,14 @@ int main(int argc, char** argv)
             }
             else if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased)
             {
-                bool down = (event.type == sf::Event::KeyPressed);
+                profiler.handleKey(event);
                 switch (event.key.code)
                 {
                     case sf::Keyboard::Escape:
                         window.close();
                         break;
+
+                    default: break;
                 }
             }
             else if (event.type == sf::Event::MouseButtonPressed)
@@ -380,58 +261,45 @@ int main(int argc, char** argv)
                         float angle = getAngleBetweenVectors(xVector, mouseClick - boxes[affectedBox].getPosition());
                         boxes[affectedBox].setRotation(angle * 180.0f / (float)PI);
                     }
-                    calcNormals(boxes, normals);
-                    calcProjections(projections, boxes, normals);
-                    for (size_t i = 0; i < collisions.size(); ++i)
-                    {
-                        collisions[i] = projections[i].collides(projections[i+normals.size()]);
-                    }
+                    shapes[affectedBox].update(boxes[affectedBox]);
+                    moved = true;
                 }
             }
         }
+        eventTime.stop();
 
-        //check collisions
-        size_t minCollision = 0;
-        float l = 0.0f;
-        for (size_t i = 1; i < collisions.size(); ++i)
+        if (moved)
         {
-            if (collisions[i].length() < collisions[minCollision].length())
-            {
-                minCollision = i;
-            }
+            sandbox::ScopedStage contactTime(profiler, contactStage);
+            sat::findContacts(shapes, broadphase, pairCache, contacts);
         }
 
-        if (collisions[minCollision].length() != 0.0f)
-        {
-            l = collisions[minCollision].length();
-        }
-        collisionVector = ProjectedSegment(collisions[minCollision].axis, 0, l, sf::Color(255,127,15));
-        collisionVector.axis.origin = boxes[0].getPosition();
-
+        sandbox::ScopedStage drawTime(profiler, drawStage);
         window.clear({ 127, 127, 127 });
         for (size_t i = 0; i < boxes.size(); ++i)
         {
             drawBox(window, boxes[i]);
         }
-        /*for (size_t i = 0; i < normals.size(); ++i)
-        {
-            window.draw(normals[i]);
-        }
-        for (size_t i = 0; i < projections.size(); ++i)
+        //minimum translation vector, drawn from every contact point
+        for (size_t i = 0; i < contacts.size(); ++i)
         {
-            window.draw((Segment)projections[i]);
+            const sat::Manifold& m = contacts[i].manifold;
+            for (size_t p = 0; p < m.pointCount; ++p)
+            {
+                window.draw(sat::Segment(m.points[p].position, m.points[p].position + m.mtv(), sf::Color(255,127,15)));
+            }
         }
-        for (size_t i = 0; i < collisions.size(); ++i)
-        {
-            window.draw((Segment)collisions[i]);
-        }*/
-        window.draw((Segment)collisionVector);
+        drawTime.stop();
+        window.draw(overlay);
         window.display();
+        profiler.endFrame();
 
         ++frames;
         if (fpsTest.getElapsedTime().asMilliseconds() > 500)
         {
             std::cout << "fps : " << frames * 2 << std::endl;
+            const sat::SatStats& stats = pairCache.getStats();
+            std::cout << "axis cache hit rate : " << stats.hitRate() << ", axes per pair : " << stats.axesPerPair() << std::endl;
             fpsTest.restart();
             frames = 0;
         }
@@ -440,21 +308,3 @@ int main(int argc, char** argv)
 
     return 0;
 }
-
-void Axis::draw(sf::RenderTarget& target, sf::RenderStates states) const
-{
-    sf::Vertex v[2];
-    v[0] = { origin - direction * 20000.0f, color };
-    v[1] = { origin + direction * 20000.0f, color };
-
-    target.draw(v, 2, sf::Lines, states);
-}
-
-void Segment::draw(sf::RenderTarget& target, sf::RenderStates states) const
-{
-    sf::Vertex v[2];
-    v[0] = { points[0], color };
-    v[1] = { points[1], color };
-
-    target.draw(v, 2, sf::Lines, states);
-}
\ No newline at end of file
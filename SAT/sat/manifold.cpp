@@ -0,0 +1,223 @@
+#include "manifold.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace sat
+{
+
+namespace
+{
+
+struct ClipVertex
+{
+    sf::Vector2f v;
+    uint8_t feature;
+};
+
+//keeps the part of the segment in that is behind the plane dot(normal, p) = offset
+size_t clipSegment(ClipVertex out[2], const ClipVertex in[2], const sf::Vector2f& normal, float offset, uint8_t side)
+{
+    size_t count = 0;
+
+    float d0 = dot(normal, in[0].v) - offset;
+    float d1 = dot(normal, in[1].v) - offset;
+
+    if (d0 <= 0.0f)
+    {
+        out[count++] = in[0];
+    }
+    if (d1 <= 0.0f)
+    {
+        out[count++] = in[1];
+    }
+
+    //the points are on both sides of the plane
+    if (d0 * d1 < 0.0f)
+    {
+        float t = d0 / (d0 - d1);
+        out[count].v = in[0].v + t * (in[1].v - in[0].v);
+        out[count].feature = side;
+        ++count;
+    }
+
+    return count;
+}
+
+//largest separation between an edge of a and the points of b
+//returns false as soon as an edge separates them
+bool findMaxSeparation(const ShapeCache& a, const ShapeCache& b, size_t& edge, float& separation, int& separatingEdge, int offset, size_t& tested)
+{
+    const std::vector<sf::Vector2f>& normals = a.getEdgeNormals();
+    separation = -std::numeric_limits<float>::max();
+    for (size_t i = 0; i < normals.size(); ++i)
+    {
+        if (normals[i].x == 0.0f && normals[i].y == 0.0f)
+        {
+            continue;
+        }
+
+        float s = edgeSeparation(a, i, b);
+        ++tested;
+        if (s >= 0.0f)
+        {
+            separatingEdge = offset + static_cast<int>(i);
+            return false;
+        }
+        if (s > separation)
+        {
+            separation = s;
+            edge = i;
+        }
+    }
+    return true;
+}
+
+} // !namespace
+
+float edgeSeparation(const ShapeCache& a, size_t edge, const ShapeCache& b)
+{
+    const sf::Vector2f& n = a.getEdgeNormals()[edge];
+    const sf::Vector2f& v = a.getPoints()[edge];
+    const std::vector<sf::Vector2f>& points = b.getPoints();
+
+    float mini = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        mini = std::min(mini, dot(n, points[i] - v));
+    }
+    return mini;
+}
+
+bool collide(const ShapeCache& a, const ShapeCache& b, Manifold& manifold, int firstEdge, int* separatingEdge, size_t* edgesTested)
+{
+    manifold = Manifold();
+
+    int separating = -1;
+    size_t tested = 0;
+    const int countA = static_cast<int>(a.getPoints().size());
+    const int countB = static_cast<int>(b.getPoints().size());
+
+    //the edge that separated the shapes last time is likely to still do it
+    if (firstEdge >= 0 && firstEdge < countA + countB)
+    {
+        const ShapeCache& s = firstEdge < countA ? a : b;
+        const ShapeCache& o = firstEdge < countA ? b : a;
+        size_t e = firstEdge < countA ? firstEdge : firstEdge - countA;
+        const sf::Vector2f& n = s.getEdgeNormals()[e];
+        if (n.x != 0.0f || n.y != 0.0f)
+        {
+            ++tested;
+            if (edgeSeparation(s, e, o) >= 0.0f)
+            {
+                separating = firstEdge;
+            }
+        }
+    }
+
+    size_t edgeA = 0, edgeB = 0;
+    float separationA = 0.0f, separationB = 0.0f;
+    if (separating != -1
+        || countA == 0 || countB == 0
+        || !findMaxSeparation(a, b, edgeA, separationA, separating, 0, tested)
+        || !findMaxSeparation(b, a, edgeB, separationB, separating, countA, tested))
+    {
+        if (separatingEdge)
+        {
+            *separatingEdge = separating;
+        }
+        if (edgesTested)
+        {
+            *edgesTested = tested;
+        }
+        return false;
+    }
+    if (separatingEdge)
+    {
+        *separatingEdge = -1;
+    }
+    if (edgesTested)
+    {
+        *edgesTested = tested;
+    }
+
+    //prefer the first shape as reference unless the second one is clearly better,
+    //so the features do not flip between frames
+    const float relativeTolerance = 0.98f;
+    const float absoluteTolerance = 0.001f;
+    bool flip = separationB > relativeTolerance * separationA + absoluteTolerance;
+
+    const ShapeCache& reference = flip ? b : a;
+    const ShapeCache& incident = flip ? a : b;
+    size_t referenceEdge = flip ? edgeB : edgeA;
+    float separation = flip ? separationB : separationA;
+
+    const std::vector<sf::Vector2f>& refPoints = reference.getPoints();
+    const std::vector<sf::Vector2f>& incPoints = incident.getPoints();
+    const sf::Vector2f n = reference.getEdgeNormals()[referenceEdge];
+
+    //the incident edge is the most antiparallel to the reference normal
+    const std::vector<sf::Vector2f>& incNormals = incident.getEdgeNormals();
+    size_t incidentEdge = 0;
+    float minDot = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < incNormals.size(); ++i)
+    {
+        float d = dot(n, incNormals[i]);
+        if (d < minDot)
+        {
+            minDot = d;
+            incidentEdge = i;
+        }
+    }
+
+    ClipVertex incidentVertices[2];
+    incidentVertices[0].v = incPoints[incidentEdge];
+    incidentVertices[0].feature = 0;
+    incidentVertices[1].v = incPoints[(incidentEdge + 1) % incPoints.size()];
+    incidentVertices[1].feature = 1;
+
+    const sf::Vector2f& v1 = refPoints[referenceEdge];
+    const sf::Vector2f& v2 = refPoints[(referenceEdge + 1) % refPoints.size()];
+
+    //unit tangent from the normal, oriented from v1 to v2
+    sf::Vector2f tangent(-n.y, n.x);
+    if (dot(tangent, v2 - v1) < 0.0f)
+    {
+        tangent = -tangent;
+    }
+
+    ClipVertex clip1[2], clip2[2];
+    size_t count = clipSegment(clip1, incidentVertices, -tangent, -dot(tangent, v1), ContactId::ClipSide1);
+
+    manifold.normal = flip ? -n : n;
+    manifold.depth = -separation;
+
+    if (count < 2)
+    {
+        return true;
+    }
+    count = clipSegment(clip2, clip1, tangent, dot(tangent, v2), ContactId::ClipSide2);
+    if (count < 2)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        float s = dot(n, clip2[i].v - v1);
+        if (s <= 0.0f)
+        {
+            ContactPoint& cp = manifold.points[manifold.pointCount++];
+            cp.position = clip2[i].v;
+            cp.separation = s;
+            cp.id.referenceEdge = static_cast<uint8_t>(referenceEdge);
+            cp.id.incidentEdge = static_cast<uint8_t>(incidentEdge);
+            cp.id.incidentFeature = clip2[i].feature;
+            cp.id.flip = flip ? 1 : 0;
+        }
+    }
+
+    return true;
+}
+
+} // !namespace sat
@@ -0,0 +1,81 @@
+#ifndef SAT_MANIFOLD_HPP
+#define SAT_MANIFOLD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "shapecache.hpp"
+
+namespace sat
+{
+
+//identifies the features that produced a contact point, so a solver can match
+//the points of two consecutive frames and reuse their impulses
+struct ContactId
+{
+    enum
+    {
+        //incidentFeature values when the point was created by a side plane of the reference edge
+        ClipSide1 = 0xfe,
+        ClipSide2 = 0xff
+    };
+
+    uint8_t referenceEdge;
+    uint8_t incidentEdge;
+    //0 or 1 for an endpoint of the incident edge, ClipSide1/2 otherwise
+    uint8_t incidentFeature;
+    //1 if the reference edge belongs to the second shape
+    uint8_t flip;
+
+    uint32_t key() const
+    {
+        return static_cast<uint32_t>(referenceEdge)
+            | static_cast<uint32_t>(incidentEdge) << 8
+            | static_cast<uint32_t>(incidentFeature) << 16
+            | static_cast<uint32_t>(flip) << 24;
+    }
+};
+
+struct ContactPoint
+{
+    //point of the incident shape inside the reference one
+    sf::Vector2f position;
+    //negative when penetrating
+    float separation;
+    ContactId id;
+};
+
+struct Manifold
+{
+    Manifold() : depth(0.0f), pointCount(0)
+    {
+    }
+
+    //unit normal going from the first shape to the second
+    sf::Vector2f normal;
+    float depth;
+    size_t pointCount;
+    ContactPoint points[2];
+
+    //moving the second shape by mtv(), or the first one by -mtv(), separates them
+    sf::Vector2f mtv() const
+    {
+        return normal * depth;
+    }
+};
+
+//smallest distance between the edge of a and the points of b along the normal of the edge
+//negative if b crosses the edge line
+float edgeSeparation(const ShapeCache& a, size_t edge, const ShapeCache& b);
+
+//finds the axis of least penetration, and clips the incident edge against the
+//reference edge to get up to two contact points, in a single pass
+//firstEdge is tested first if it is valid (edges of a, then the ones of b), and the
+//test stops at the first separating edge, which is written to separatingEdge if given
+//edgesTested receives the number of edges whose separation was computed
+//returns false if a and b do not overlap, touching shapes included
+bool collide(const ShapeCache& a, const ShapeCache& b, Manifold& manifold, int firstEdge = -1, int* separatingEdge = nullptr, size_t* edgesTested = nullptr);
+
+} // !namespace sat
+
+#endif // SAT_MANIFOLD_HPP
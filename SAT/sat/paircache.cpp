@@ -0,0 +1,92 @@
+#include "paircache.hpp"
+
+namespace sat
+{
+
+void PairCache::newFrame()
+{
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->second.frame != _frame)
+        {
+            it = _entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    ++_frame;
+}
+
+bool PairCache::collides(size_t a, const sf::RectangleShape& boxA, size_t b, const sf::RectangleShape& boxB, ProjectedSegment* minOverlap)
+{
+    return test(a, boxA, b, boxB, minOverlap);
+}
+
+bool PairCache::collides(size_t a, const ShapeCache& shapeA, size_t b, const ShapeCache& shapeB, ProjectedSegment* minOverlap)
+{
+    return test(a, shapeA, b, shapeB, minOverlap);
+}
+
+bool PairCache::collide(size_t a, const ShapeCache& shapeA, size_t b, const ShapeCache& shapeB, Manifold& manifold)
+{
+    Entry& e = find(a, b);
+    bool lookup = e.edge != -1;
+    int firstEdge = e.edge;
+
+    int separatingEdge;
+    size_t tested;
+    sat::collide(shapeA, shapeB, manifold, firstEdge, &separatingEdge, &tested);
+
+    record(e, e.edge, lookup, firstEdge, separatingEdge, tested);
+    return separatingEdge == -1;
+}
+
+template <typename Shape>
+bool PairCache::test(size_t a, const Shape& shapeA, size_t b, const Shape& shapeB, ProjectedSegment* minOverlap)
+{
+    Entry& e = find(a, b);
+    bool lookup = e.axis != -1;
+    int firstAxis = lookup ? e.axis : 0;
+
+    int separatingAxis;
+    size_t tested = findSeparatingAxis(shapeA, shapeB, firstAxis, separatingAxis, minOverlap);
+
+    record(e, e.axis, lookup, firstAxis, separatingAxis, tested);
+    return separatingAxis == -1;
+}
+
+PairCache::Entry& PairCache::find(size_t a, size_t b)
+{
+    uint64_t key = (static_cast<uint64_t>(a) << 32) | static_cast<uint64_t>(b);
+    auto it = _entries.find(key);
+    if (it == _entries.end())
+    {
+        Entry e;
+        e.axis = -1;
+        e.edge = -1;
+        e.frame = _frame;
+        it = _entries.insert(std::make_pair(key, e)).first;
+    }
+    return it->second;
+}
+
+void PairCache::record(Entry& e, int& hint, bool lookup, int firstAxis, int separatingAxis, size_t tested)
+{
+    ++_stats.pairs;
+    _stats.axesTested += tested;
+    if (lookup)
+    {
+        ++_stats.lookups;
+        if (tested == 1 && separatingAxis == firstAxis)
+        {
+            ++_stats.cacheHits;
+        }
+    }
+
+    hint = separatingAxis;
+    e.frame = _frame;
+}
+
+} // !namespace sat
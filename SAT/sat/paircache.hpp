@@ -0,0 +1,97 @@
+#ifndef SAT_PAIRCACHE_HPP
+#define SAT_PAIRCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "sat.hpp"
+#include "shapecache.hpp"
+#include "manifold.hpp"
+
+namespace sat
+{
+
+struct SatStats
+{
+    SatStats() : pairs(0), lookups(0), cacheHits(0), axesTested(0)
+    {
+    }
+
+    size_t pairs;
+    //pairs that had a separating axis cached from the last frame
+    size_t lookups;
+    //lookups where that axis still separated the pair
+    size_t cacheHits;
+    size_t axesTested;
+
+    float hitRate() const
+    {
+        return lookups ? static_cast<float>(cacheHits) / lookups : 0.0f;
+    }
+
+    float axesPerPair() const
+    {
+        return pairs ? static_cast<float>(axesTested) / pairs : 0.0f;
+    }
+};
+
+//remembers the axis that separated each pair during the last frame and tests it first,
+//slow moving objects are usually still separated by the same axis
+class PairCache
+{
+    public:
+
+        PairCache() : _frame(0)
+        {
+        }
+
+        //forgets the pairs that were not tested during the last frame
+        void newFrame();
+
+        //same as sat::collides, a and b are the indices identifying the pair
+        bool collides(size_t a, const sf::RectangleShape& boxA, size_t b, const sf::RectangleShape& boxB, ProjectedSegment* minOverlap = nullptr);
+
+        bool collides(size_t a, const ShapeCache& shapeA, size_t b, const ShapeCache& shapeB, ProjectedSegment* minOverlap = nullptr);
+
+        //same as sat::collide, the separating edge is cached apart from the axis of collides
+        bool collide(size_t a, const ShapeCache& shapeA, size_t b, const ShapeCache& shapeB, Manifold& manifold);
+
+        const SatStats& getStats() const
+        {
+            return _stats;
+        }
+
+        void resetStats()
+        {
+            _stats = SatStats();
+        }
+
+    private:
+
+        template <typename Shape>
+        bool test(size_t a, const Shape& shapeA, size_t b, const Shape& shapeB, ProjectedSegment* minOverlap);
+
+        //the axis index of collides() and the edge index of collide() do not mean the
+        //same thing, a pair tested both ways keeps one of each, -1 if none is cached
+        struct Entry
+        {
+            int axis;
+            int edge;
+            unsigned int frame;
+        };
+
+        //the entry of the pair, created empty if it was not tested during the last frame
+        Entry& find(size_t a, size_t b);
+
+        //stores separatingAxis in hint, lookup is set if hint held one before the test
+        void record(Entry& e, int& hint, bool lookup, int firstAxis, int separatingAxis, size_t tested);
+
+        std::unordered_map<uint64_t, Entry> _entries;
+        unsigned int _frame;
+        SatStats _stats;
+};
+
+} // !namespace sat
+
+#endif // SAT_PAIRCACHE_HPP
@@ -0,0 +1,11 @@
+#include "polygon.hpp"
+
+namespace sat
+{
+
+bool collides(const sf::Shape& a, const sf::Shape& b, ProjectedSegment* minOverlap)
+{
+    return collidesConvex(a, b, minOverlap);
+}
+
+} // !namespace sat
@@ -0,0 +1,211 @@
+#ifndef SAT_POLYGON_HPP
+#define SAT_POLYGON_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "sat.hpp"
+
+namespace sat
+{
+
+//what is known about a shape type at compile time
+//points is the number of vertices, axes the number of edges whose normals
+//are enough to describe the shape. 0 means it is only known at runtime
+template <typename Shape>
+struct ShapeTraits
+{
+    static const size_t points = 0;
+    static const size_t axes = 0;
+};
+
+//edges 2 and 3 of a box are parallel to edges 0 and 1
+template <>
+struct ShapeTraits<sf::RectangleShape>
+{
+    static const size_t points = 4;
+    static const size_t axes = 2;
+};
+
+//list stored in place when its maximum size N is known, in a vector otherwise
+template <typename T, size_t N>
+class FixedList
+{
+    public:
+
+        FixedList() : _count(0)
+        {
+        }
+
+        void push_back(const T& v)
+        {
+            _items[_count++] = v;
+        }
+
+        void resize(size_t n)
+        {
+            _count = n;
+        }
+
+        size_t size() const
+        {
+            return _count;
+        }
+
+        T& operator[](size_t i)
+        {
+            return _items[i];
+        }
+
+        const T& operator[](size_t i) const
+        {
+            return _items[i];
+        }
+
+    private:
+        std::array<T, N> _items;
+        size_t _count;
+};
+
+template <typename T>
+class FixedList<T, 0> : public std::vector<T>
+{
+};
+
+//smallest axis list able to hold the axes of a shape of type A and one of type B
+template <size_t NA, size_t NB>
+struct AxisListFor
+{
+    typedef FixedList<Axis, NA + NB> type;
+};
+
+template <size_t NA>
+struct AxisListFor<NA, 0>
+{
+    typedef FixedList<Axis, 0> type;
+};
+
+template <size_t NB>
+struct AxisListFor<0, NB>
+{
+    typedef FixedList<Axis, 0> type;
+};
+
+template <>
+struct AxisListFor<0, 0>
+{
+    typedef FixedList<Axis, 0> type;
+};
+
+template <typename Shape, typename PointList>
+void transformPoints(const Shape& shape, PointList& points)
+{
+    const sf::Transform& t = shape.getTransform();
+    points.resize(shape.getPointCount());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        points[i] = t.transformPoint(shape.getPoint(i));
+    }
+}
+
+//appends the normals of the first edges of the polygon to axes
+//normals parallel or antiparallel to one already in the list are skipped
+template <typename PointList, typename AxisList>
+void addUniqueNormals(const PointList& points, size_t edges, AxisList& axes)
+{
+    const float epsilon = 1e-5f;
+    const size_t count = points.size();
+    for (size_t e = 0; e < edges; ++e)
+    {
+        sf::Vector2f d = points[(e + 1) % count] - points[e];
+        if (d.x == 0.0f && d.y == 0.0f)
+        {
+            continue;
+        }
+        sf::Vector2f n = normalize(sf::Vector2f(d.y, -d.x));
+
+        bool parallel = false;
+        for (size_t i = 0; i < axes.size() && !parallel; ++i)
+        {
+            const sf::Vector2f& o = axes[i].direction;
+            parallel = std::abs(o.x * n.y - o.y * n.x) < epsilon;
+        }
+        if (!parallel)
+        {
+            axes.push_back(Axis(sf::Vector2f(0.0f, 0.0f), n));
+        }
+    }
+}
+
+template <typename PointList>
+ProjectedSegment projectPoints(const PointList& points, const Axis& axis)
+{
+    float mini = project(points[0], axis);
+    float maxi = mini;
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+        float p = project(points[i], axis);
+        mini = std::min(mini, p);
+        maxi = std::max(maxi, p);
+    }
+    return ProjectedSegment(axis, mini, maxi, sf::Color::White);
+}
+
+//SAT between two convex polygons of any vertex count
+//when the types of both shapes are known at compile time through ShapeTraits,
+//the points and axes are kept on the stack and only the needed edges are used
+//returns true if they collide and stores the smallest overlap in minOverlap
+//axesTested, if given, receives the number of axes that were projected on
+template <typename A, typename B>
+bool collidesConvex(const A& a, const B& b, ProjectedSegment* minOverlap = nullptr, size_t* axesTested = nullptr)
+{
+    typedef ShapeTraits<A> TA;
+    typedef ShapeTraits<B> TB;
+
+    FixedList<sf::Vector2f, TA::points> pa;
+    FixedList<sf::Vector2f, TB::points> pb;
+    transformPoints(a, pa);
+    transformPoints(b, pb);
+
+    typename AxisListFor<TA::axes, TB::axes>::type axes;
+    addUniqueNormals(pa, TA::axes ? TA::axes : pa.size(), axes);
+    addUniqueNormals(pb, TB::axes ? TB::axes : pb.size(), axes);
+
+    ProjectedSegment smallest;
+    bool collision = true;
+    size_t tested = 0;
+    for (size_t i = 0; i < axes.size(); ++i)
+    {
+        ProjectedSegment overlap = projectPoints(pa, axes[i]).collides(projectPoints(pb, axes[i]));
+        ++tested;
+        if (overlap.length() == 0.0f)
+        {
+            smallest = ProjectedSegment();
+            collision = false;
+            break;
+        }
+        if (i == 0 || overlap.length() < smallest.length())
+        {
+            smallest = overlap;
+        }
+    }
+
+    if (minOverlap)
+    {
+        *minOverlap = smallest;
+    }
+    if (axesTested)
+    {
+        *axesTested = tested;
+    }
+    return collision;
+}
+
+//runtime version for any pair of convex sf::Shape, all edges are used
+bool collides(const sf::Shape& a, const sf::Shape& b, ProjectedSegment* minOverlap = nullptr);
+
+} // !namespace sat
+
+#endif // SAT_POLYGON_HPP
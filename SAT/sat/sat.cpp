@@ -0,0 +1,125 @@
+#include "sat.hpp"
+
+#include <algorithm>
+
+namespace sat
+{
+
+ProjectedSegment ProjectedSegment::collides(const ProjectedSegment& other) const
+{
+    if (other.axis != axis || mini > other.maxi || other.mini > maxi)
+    {
+        return ProjectedSegment();
+    }
+
+    float x1 = std::max(mini, other.mini);
+    float x2 = std::min(maxi, other.maxi);
+
+    return ProjectedSegment(axis, x1, x2, sf::Color::White);
+}
+
+Axis calcNormal(const sf::RectangleShape& box, size_t edge)
+{
+    int colorReduction = 3;
+    sf::Transform t = box.getTransform();
+    Segment s(t.transformPoint(box.getPoint(edge)), t.transformPoint(box.getPoint((edge + 1) % 4)), box.getFillColor());
+    s.color.r /= colorReduction;
+    s.color.g /= colorReduction;
+    s.color.b /= colorReduction;
+    return s.getNormal();
+}
+
+void calcNormals(const sf::RectangleShape& box, Axis* normals)
+{
+    normals[0] = calcNormal(box, 0);
+    normals[1] = calcNormal(box, 1);
+}
+
+float project(const sf::Vector2f& v, const Axis& axis)
+{
+    return dot(v-axis.origin, axis.direction);
+}
+
+ProjectedSegment project(const sf::RectangleShape& box, const Axis& axis)
+{
+    const sf::Transform& t = box.getTransform();
+    std::array<float, 4> projections;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        projections[i] = project(t.transformPoint(box.getPoint(i)), axis);
+    }
+
+    float mini = projections[0], maxi = projections[0];
+    for (size_t i = 1; i < 4; ++i)
+    {
+        if (projections[i] < mini)
+        {
+            mini = projections[i];
+        }
+        else if(projections[i] > maxi)
+        {
+            maxi = projections[i];
+        }
+    }
+
+    return ProjectedSegment(axis, mini, maxi, sf::Color::White);
+}
+
+size_t findSeparatingAxis(const sf::RectangleShape& a, const sf::RectangleShape& b, int firstAxis, int& separatingAxis, ProjectedSegment* minOverlap)
+{
+    ProjectedSegment smallest;
+    size_t tested = 0;
+    separatingAxis = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        //firstAxis goes first, then the others in order
+        int n = (i == 0) ? firstAxis : (i <= firstAxis ? i - 1 : i);
+        Axis axis = calcNormal(n < 2 ? a : b, n % 2);
+        ProjectedSegment overlap = project(a, axis).collides(project(b, axis));
+        ++tested;
+
+        if (overlap.length() == 0.0f)
+        {
+            separatingAxis = n;
+            smallest = ProjectedSegment();
+            break;
+        }
+        if (i == 0 || overlap.length() < smallest.length())
+        {
+            smallest = overlap;
+        }
+    }
+
+    if (minOverlap)
+    {
+        *minOverlap = smallest;
+    }
+    return tested;
+}
+
+bool collides(const sf::RectangleShape& a, const sf::RectangleShape& b, ProjectedSegment* minOverlap)
+{
+    int separatingAxis;
+    findSeparatingAxis(a, b, 0, separatingAxis, minOverlap);
+    return separatingAxis == -1;
+}
+
+void Axis::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    sf::Vertex v[2];
+    v[0] = { origin - direction * 20000.0f, color };
+    v[1] = { origin + direction * 20000.0f, color };
+
+    target.draw(v, 2, sf::Lines, states);
+}
+
+void Segment::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    sf::Vertex v[2];
+    v[0] = { points[0], color };
+    v[1] = { points[1], color };
+
+    target.draw(v, 2, sf::Lines, states);
+}
+
+} // !namespace sat
@@ -0,0 +1,157 @@
+#ifndef SAT_SAT_HPP
+#define SAT_SAT_HPP
+
+#include <cmath>
+#include <array>
+
+#include <SFML/Graphics.hpp>
+
+namespace sat
+{
+
+template <typename T>
+float norm2(const sf::Vector2<T>& a)
+{
+    return static_cast<float>(a.x*a.x + a.y*a.y);
+}
+
+template <typename T>
+float norm(const sf::Vector2<T>& a)
+{
+    return std::sqrt(norm2(a));
+}
+
+template <typename T>
+sf::Vector2<T> normalize(const sf::Vector2<T>& vec)
+{
+    T n = norm(vec);
+    return sf::Vector2<T>(T(vec.x / n), T(vec.y / n));
+}
+
+template <typename T>
+T dot(const sf::Vector2<T>& a, const sf::Vector2<T>& b) {
+    return a.x*b.x + a.y*b.y;
+}
+
+class Axis : public sf::Drawable
+{
+    public:
+
+        Axis(const sf::Vector2f& o = { 0, 0 }, const sf::Vector2f& d = { 0, 0 }, const sf::Color& c = sf::Color::Black)
+        {
+            origin = o;
+            direction = d;
+            color = c;
+        }
+
+        bool operator!=(const Axis& o) const
+        {
+            return origin != o.origin || direction != o.direction;
+        }
+
+        sf::Vector2f origin;
+        sf::Vector2f direction;
+        sf::Color color;
+
+    protected:
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
+
+class Segment : public sf::Drawable
+{
+    public:
+        std::array<sf::Vector2f,2> points;
+        sf::Color color;
+
+        Segment(const Axis& a) : Segment(a.origin, a.origin + a.direction, a.color)
+        {
+        }
+
+        Segment(const sf::Vector2f& a = { 0, 0 }, const sf::Vector2f& b = { 0, 0 }, const sf::Color& c = sf::Color::Black)
+        {
+            points[0] = a;
+            points[1] = b;
+            color = c;
+        }
+
+        Axis getNormal() const
+        {
+            sf::Vector2f d = points[1] - points[0];
+            Axis a;
+            a.origin = points[0] + d / 2.0f;
+            a.direction = normalize(sf::Vector2f(d.y, -d.x));
+            a.color = color;
+            return a;
+        }
+
+        sf::Vector2f getDirection() const
+        {
+            return points[1] - points[0];
+        }
+
+        float norm() const
+        {
+            return sat::norm(points[1] - points[0]);
+        }
+
+    protected:
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
+
+class ProjectedSegment
+{
+    public:
+        ProjectedSegment(const Axis& a = Axis(), float mn = 0.0f, float mx = 0.0f, const sf::Color& c = sf::Color::Black)
+        {
+            axis = a;
+            mini = mn;
+            maxi = mx;
+            color = c;
+        }
+
+        operator Segment() const
+        {
+            return Segment(axis.origin + mini * axis.direction, axis.origin + maxi * axis.direction, color);
+        }
+
+        //returns the overlap of both segments, or an empty segment if they are
+        //separated or not projected on the same axis
+        ProjectedSegment collides(const ProjectedSegment& other) const;
+
+        float length() const
+        {
+            return std::abs(maxi - mini);
+        }
+
+        Axis axis;
+        float mini;
+        float maxi;
+        sf::Color color;
+};
+
+//computes the normal of edge i>i+1 of box
+Axis calcNormal(const sf::RectangleShape& box, size_t edge);
+
+//computes the normals of the two distinct edges of box
+//normals[0] is the normal of edge 0>1, normals[1] the one of edge 1>2
+void calcNormals(const sf::RectangleShape& box, Axis* normals);
+
+//returns distance from axis center to point
+float project(const sf::Vector2f& v, const Axis& axis);
+
+ProjectedSegment project(const sf::RectangleShape& box, const Axis& axis);
+
+//tests the 4 axes of a and b starting with firstAxis (0 and 1 are the normals of a,
+//2 and 3 the ones of b) and stops at the first one that separates the boxes
+//separatingAxis is set to -1 if none does, and minOverlap to the smallest overlap
+//returns the number of axes that were tested
+size_t findSeparatingAxis(const sf::RectangleShape& a, const sf::RectangleShape& b, int firstAxis, int& separatingAxis, ProjectedSegment* minOverlap = nullptr);
+
+//narrowphase between two oriented boxes
+//returns true if they overlap on all 4 axes, and stores the smallest overlap in minOverlap
+//touching boxes (overlap of length 0) are not considered colliding
+bool collides(const sf::RectangleShape& a, const sf::RectangleShape& b, ProjectedSegment* minOverlap = nullptr);
+
+} // !namespace sat
+
+#endif // SAT_SAT_HPP
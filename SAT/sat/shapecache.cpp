@@ -0,0 +1,191 @@
+#include "shapecache.hpp"
+#include "polygon.hpp"
+
+namespace sat
+{
+
+namespace
+{
+
+const double PI = 3.14159265359;
+
+sf::Vector2f transformNormal(sf::Vector2f n, float c, float s, const sf::Vector2f& scale, bool uniform)
+{
+    //normals are transformed by the rotation and the inverse scale
+    //with a uniform scale only its sign matters and they stay unit length
+    if (uniform)
+    {
+        n = scale.x < 0.0f ? -n : n;
+    }
+    else
+    {
+        n = sf::Vector2f(n.x / scale.x, n.y / scale.y);
+    }
+    n = sf::Vector2f(c * n.x - s * n.y, s * n.x + c * n.y);
+    if (!uniform)
+    {
+        n = normalize(n);
+    }
+    return n;
+}
+
+} // !namespace
+
+ShapeCache::ShapeCache() : _rotation(0.0f), _dirty(true)
+{
+}
+
+ShapeCache::ShapeCache(const sf::Shape& shape) : _rotation(0.0f), _dirty(true)
+{
+    setGeometry(shape);
+    update(shape);
+}
+
+void ShapeCache::setGeometry(const sf::Shape& shape)
+{
+    _localPoints.resize(shape.getPointCount());
+    for (size_t i = 0; i < _localPoints.size(); ++i)
+    {
+        _localPoints[i] = shape.getPoint(i);
+    }
+
+    FixedList<Axis, 0> axes;
+    addUniqueNormals(_localPoints, _localPoints.size(), axes);
+    _localNormals.resize(axes.size());
+    for (size_t i = 0; i < axes.size(); ++i)
+    {
+        _localNormals[i] = axes[i].direction;
+    }
+
+    //(d.y, -d.x) points outward when the points have a positive signed area
+    float area = 0.0f;
+    for (size_t i = 0; i < _localPoints.size(); ++i)
+    {
+        const sf::Vector2f& p = _localPoints[i];
+        const sf::Vector2f& q = _localPoints[(i + 1) % _localPoints.size()];
+        area += p.x * q.y - q.x * p.y;
+    }
+    float orientation = area < 0.0f ? -1.0f : 1.0f;
+
+    _localEdgeNormals.resize(_localPoints.size());
+    for (size_t i = 0; i < _localPoints.size(); ++i)
+    {
+        sf::Vector2f d = _localPoints[(i + 1) % _localPoints.size()] - _localPoints[i];
+        _localEdgeNormals[i] = (d.x == 0.0f && d.y == 0.0f) ? d : normalize(sf::Vector2f(d.y, -d.x)) * orientation;
+    }
+
+    _points.resize(_localPoints.size());
+    _normals.resize(_localNormals.size());
+    _edgeNormals.resize(_localEdgeNormals.size());
+    _dirty = true;
+}
+
+bool ShapeCache::update(const sf::Transformable& shape)
+{
+    if (!_dirty
+        && shape.getPosition() == _position
+        && shape.getRotation() == _rotation
+        && shape.getScale() == _scale
+        && shape.getOrigin() == _origin)
+    {
+        return false;
+    }
+
+    rebuild(shape);
+    return true;
+}
+
+void ShapeCache::rebuild(const sf::Transformable& shape)
+{
+    _position = shape.getPosition();
+    _rotation = shape.getRotation();
+    _scale = shape.getScale();
+    _origin = shape.getOrigin();
+    _dirty = false;
+
+    const sf::Transform& t = shape.getTransform();
+    for (size_t i = 0; i < _points.size(); ++i)
+    {
+        _points[i] = t.transformPoint(_localPoints[i]);
+    }
+
+    if (!_points.empty())
+    {
+        float left = _points[0].x, right = _points[0].x;
+        float top = _points[0].y, bottom = _points[0].y;
+        for (size_t i = 1; i < _points.size(); ++i)
+        {
+            left = std::min(left, _points[i].x);
+            right = std::max(right, _points[i].x);
+            top = std::min(top, _points[i].y);
+            bottom = std::max(bottom, _points[i].y);
+        }
+        _bounds = sf::FloatRect(left, top, right - left, bottom - top);
+    }
+
+    float angle = static_cast<float>(_rotation * PI / 180.0);
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    bool uniform = _scale.x == _scale.y;
+    for (size_t i = 0; i < _normals.size(); ++i)
+    {
+        _normals[i] = Axis(sf::Vector2f(0.0f, 0.0f), transformNormal(_localNormals[i], c, s, _scale, uniform));
+    }
+
+    for (size_t i = 0; i < _edgeNormals.size(); ++i)
+    {
+        _edgeNormals[i] = transformNormal(_localEdgeNormals[i], c, s, _scale, uniform);
+    }
+}
+
+ProjectedSegment project(const ShapeCache& shape, const Axis& axis)
+{
+    return projectPoints(shape.getPoints(), axis);
+}
+
+size_t findSeparatingAxis(const ShapeCache& a, const ShapeCache& b, int firstAxis, int& separatingAxis, ProjectedSegment* minOverlap)
+{
+    const int countA = static_cast<int>(a.getNormals().size());
+    const int count = countA + static_cast<int>(b.getNormals().size());
+    if (firstAxis < 0 || firstAxis >= count)
+    {
+        firstAxis = 0;
+    }
+
+    ProjectedSegment smallest;
+    size_t tested = 0;
+    separatingAxis = -1;
+    for (int i = 0; i < count; ++i)
+    {
+        int n = (i == 0) ? firstAxis : (i <= firstAxis ? i - 1 : i);
+        const Axis& axis = n < countA ? a.getNormals()[n] : b.getNormals()[n - countA];
+        ProjectedSegment overlap = project(a, axis).collides(project(b, axis));
+        ++tested;
+
+        if (overlap.length() == 0.0f)
+        {
+            separatingAxis = n;
+            smallest = ProjectedSegment();
+            break;
+        }
+        if (i == 0 || overlap.length() < smallest.length())
+        {
+            smallest = overlap;
+        }
+    }
+
+    if (minOverlap)
+    {
+        *minOverlap = smallest;
+    }
+    return tested;
+}
+
+bool collides(const ShapeCache& a, const ShapeCache& b, ProjectedSegment* minOverlap)
+{
+    int separatingAxis;
+    findSeparatingAxis(a, b, 0, separatingAxis, minOverlap);
+    return separatingAxis == -1;
+}
+
+} // !namespace sat
@@ -0,0 +1,82 @@
+#ifndef SAT_SHAPECACHE_HPP
+#define SAT_SHAPECACHE_HPP
+
+#include <vector>
+
+#include "sat.hpp"
+
+namespace sat
+{
+
+//world space points and unit edge normals of a convex shape
+//they are only rebuilt when the transform of the shape changes, and the normals
+//are obtained by rotating the local ones, so no sqrt is needed after setGeometry
+class ShapeCache
+{
+    public:
+
+        ShapeCache();
+
+        explicit ShapeCache(const sf::Shape& shape);
+
+        //reads the local points of shape and computes their unit normals
+        //parallel normals are only kept once. Call it again if the points change
+        void setGeometry(const sf::Shape& shape);
+
+        //rebuilds the world space buffers if the position, rotation, scale or origin
+        //of shape changed since the last update. Returns true if they were rebuilt
+        bool update(const sf::Transformable& shape);
+
+        const std::vector<sf::Vector2f>& getPoints() const
+        {
+            return _points;
+        }
+
+        const std::vector<Axis>& getNormals() const
+        {
+            return _normals;
+        }
+
+        //outward unit normal of every edge i>i+1, parallel ones included
+        const std::vector<sf::Vector2f>& getEdgeNormals() const
+        {
+            return _edgeNormals;
+        }
+
+        const sf::FloatRect& getBounds() const
+        {
+            return _bounds;
+        }
+
+    private:
+
+        void rebuild(const sf::Transformable& shape);
+
+        std::vector<sf::Vector2f> _localPoints;
+        std::vector<sf::Vector2f> _localNormals;
+        std::vector<sf::Vector2f> _localEdgeNormals;
+
+        std::vector<sf::Vector2f> _points;
+        std::vector<Axis> _normals;
+        std::vector<sf::Vector2f> _edgeNormals;
+        sf::FloatRect _bounds;
+
+        //transform the buffers were built with
+        sf::Vector2f _position;
+        sf::Vector2f _scale;
+        sf::Vector2f _origin;
+        float _rotation;
+        bool _dirty;
+};
+
+ProjectedSegment project(const ShapeCache& shape, const Axis& axis);
+
+//same as the sf::RectangleShape version, axes 0 to a.getNormals().size()-1 are the ones
+//of a, the next ones the ones of b
+size_t findSeparatingAxis(const ShapeCache& a, const ShapeCache& b, int firstAxis, int& separatingAxis, ProjectedSegment* minOverlap = nullptr);
+
+bool collides(const ShapeCache& a, const ShapeCache& b, ProjectedSegment* minOverlap = nullptr);
+
+} // !namespace sat
+
+#endif // SAT_SHAPECACHE_HPP
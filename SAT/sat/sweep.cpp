@@ -0,0 +1,92 @@
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace sat
+{
+
+namespace
+{
+
+template <typename Shape>
+bool sweepAxes(const Shape& a, const sf::Vector2f& da, const Shape& b, const sf::Vector2f& db, const Axis* axes, size_t count, TimeOfImpact& toi)
+{
+    //a stays still and b moves by the relative displacement
+    const sf::Vector2f d = db - da;
+
+    float first = -std::numeric_limits<float>::max();
+    float last = std::numeric_limits<float>::max();
+    sf::Vector2f normal;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!sweep(project(a, axes[i]), project(b, axes[i]), dot(d, axes[i].direction), first, last, normal))
+        {
+            return false;
+        }
+    }
+
+    if (first > 1.0f || last < 0.0f)
+    {
+        return false;
+    }
+
+    toi.first = first;
+    toi.last = last;
+    toi.normal = normal;
+    return true;
+}
+
+} // !namespace
+
+bool sweep(const ProjectedSegment& a, const ProjectedSegment& b, float speed, float& first, float& last, sf::Vector2f& normal)
+{
+    if (speed == 0.0f)
+    {
+        //they overlap either all the time or never
+        return a.mini < b.maxi && b.mini < a.maxi;
+    }
+
+    //times where b.maxi reaches a.mini and b.mini reaches a.maxi
+    float enter = (a.mini - b.maxi) / speed;
+    float exit = (a.maxi - b.mini) / speed;
+    sf::Vector2f n = -a.axis.direction;
+    if (speed < 0.0f)
+    {
+        std::swap(enter, exit);
+        n = a.axis.direction;
+    }
+
+    if (enter > first)
+    {
+        first = enter;
+        normal = n;
+    }
+    last = std::min(last, exit);
+
+    return first < last;
+}
+
+bool sweep(const sf::RectangleShape& a, const sf::Vector2f& da, const sf::RectangleShape& b, const sf::Vector2f& db, TimeOfImpact& toi)
+{
+    Axis axes[4];
+    calcNormals(a, axes);
+    calcNormals(b, axes + 2);
+    return sweepAxes(a, da, b, db, axes, 4, toi);
+}
+
+bool sweep(const ShapeCache& a, const sf::Vector2f& da, const ShapeCache& b, const sf::Vector2f& db, TimeOfImpact& toi)
+{
+    if (a.getPoints().empty() || b.getPoints().empty())
+    {
+        return false;
+    }
+
+    const std::vector<Axis>& na = a.getNormals();
+    const std::vector<Axis>& nb = b.getNormals();
+    std::vector<Axis> axes(na.begin(), na.end());
+    axes.insert(axes.end(), nb.begin(), nb.end());
+    return sweepAxes(a, da, b, db, axes.data(), axes.size(), toi);
+}
+
+} // !namespace sat
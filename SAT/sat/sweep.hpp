@@ -0,0 +1,42 @@
+#ifndef SAT_SWEEP_HPP
+#define SAT_SWEEP_HPP
+
+#include "sat.hpp"
+#include "shapecache.hpp"
+
+namespace sat
+{
+
+//times are fractions of the displacements given to sweep, 0 being the start
+//of the frame and 1 its end
+struct TimeOfImpact
+{
+    TimeOfImpact() : first(0.0f), last(0.0f)
+    {
+    }
+
+    //first time the shapes touch, negative if they already overlap at time 0
+    float first;
+    //last time they touch if they kept moving
+    float last;
+    //unit normal of the axis that is crossed last, going from the first shape to the second
+    sf::Vector2f normal;
+};
+
+//narrows [first, last] to the times where the segments overlap when b moves by
+//speed along their axis per unit of time, relative to a
+//normal receives the axis direction, signed from a to b, if it moved first forward
+//returns false if they can not overlap during [first, last]
+bool sweep(const ProjectedSegment& a, const ProjectedSegment& b, float speed, float& first, float& last, sf::Vector2f& normal);
+
+//swept SAT between two boxes translated by da and db during the frame
+//rotations are not interpolated, the shapes keep the orientation they have
+//returns true if they touch at some time between 0 and 1
+bool sweep(const sf::RectangleShape& a, const sf::Vector2f& da, const sf::RectangleShape& b, const sf::Vector2f& db, TimeOfImpact& toi);
+
+//same as above on cached shapes, which must be up to date with the start of the frame
+bool sweep(const ShapeCache& a, const sf::Vector2f& da, const ShapeCache& b, const sf::Vector2f& db, TimeOfImpact& toi);
+
+} // !namespace sat
+
+#endif // SAT_SWEEP_HPP
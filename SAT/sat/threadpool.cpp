@@ -0,0 +1,149 @@
+#include "threadpool.hpp"
+
+#include <algorithm>
+
+namespace sat
+{
+
+ThreadPool::ThreadPool(size_t threads) : _task(nullptr), _remaining(0), _generation(0), _quit(false)
+{
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (size_t i = 0; i < threads; ++i)
+    {
+        _queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+    for (size_t i = 1; i < threads; ++i)
+    {
+        _threads.push_back(std::thread(&ThreadPool::run, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _wake.notify_all();
+    for (size_t i = 0; i < _threads.size(); ++i)
+    {
+        _threads[i].join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const Task& task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = (count + grain - 1) / grain;
+    if (size() == 1 || chunks == 1)
+    {
+        task(0, count, 0);
+        return;
+    }
+
+    _task = &task;
+    _remaining = chunks;
+
+    //contiguous chunks per thread, so each one starts on items close to each other
+    const size_t perThread = (chunks + size() - 1) / size();
+    for (size_t t = 0; t < size(); ++t)
+    {
+        Queue& q = *_queues[t];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        for (size_t c = t * perThread; c < std::min(chunks, (t + 1) * perThread); ++c)
+        {
+            Range r;
+            r.begin = c * grain;
+            r.end = std::min(count, r.begin + grain);
+            q.ranges.push_back(r);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    while (runOne(0))
+    {
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this] { return _remaining == 0; });
+    _task = nullptr;
+}
+
+void ThreadPool::run(size_t thread)
+{
+    unsigned generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [&] { return _quit || _generation != generation; });
+            if (_quit)
+            {
+                return;
+            }
+            generation = _generation;
+        }
+
+        while (runOne(thread))
+        {
+        }
+    }
+}
+
+bool ThreadPool::runOne(size_t thread)
+{
+    Range r;
+    bool found = false;
+
+    {
+        Queue& own = *_queues[thread];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.ranges.empty())
+        {
+            r = own.ranges.back();
+            own.ranges.pop_back();
+            found = true;
+        }
+    }
+
+    for (size_t i = 1; i < size() && !found; ++i)
+    {
+        Queue& victim = *_queues[(thread + i) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ranges.empty())
+        {
+            r = victim.ranges.front();
+            victim.ranges.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    (*_task)(r.begin, r.end, thread);
+
+    if (--_remaining == 0)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _done.notify_all();
+    }
+    return true;
+}
+
+} // !namespace sat
@@ -0,0 +1,80 @@
+#ifndef SAT_THREADPOOL_HPP
+#define SAT_THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sat
+{
+
+//fixed set of threads running the chunks of parallelFor
+//every thread has its own queue of chunks, takes work from its back and steals
+//from the front of the other queues once it is empty
+class ThreadPool
+{
+    public:
+
+        //called on the items [begin, end), thread is the index of the running thread
+        typedef std::function<void(size_t begin, size_t end, size_t thread)> Task;
+
+        //threads includes the calling thread, so 1 runs everything on it
+        //0 uses the number of hardware threads
+        explicit ThreadPool(size_t threads = 0);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t size() const
+        {
+            return _queues.size();
+        }
+
+        //splits [0, count) into chunks of grain items, runs task on all of them
+        //and returns when they are done. The calling thread is thread 0
+        //task must not throw
+        void parallelFor(size_t count, size_t grain, const Task& task);
+
+    private:
+
+        struct Range
+        {
+            size_t begin;
+            size_t end;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Range> ranges;
+        };
+
+        void run(size_t thread);
+
+        //runs one chunk of the own queue of thread or stolen from another one
+        //returns false if all the queues are empty
+        bool runOne(size_t thread);
+
+        std::vector<std::unique_ptr<Queue>> _queues;
+        std::vector<std::thread> _threads;
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+        const Task* _task;
+        std::atomic<size_t> _remaining;
+        unsigned _generation;
+        bool _quit;
+};
+
+} // !namespace sat
+
+#endif // SAT_THREADPOOL_HPP
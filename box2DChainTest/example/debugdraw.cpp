@@ -0,0 +1,216 @@
+#include "debugdraw.hpp"
+
+#include <cmath>
+
+namespace {
+
+const sf::Color POLYGON_COLOR = sf::Color::Red;
+const sf::Color CIRCLE_COLOR = sf::Color(100, 100, 255);
+const sf::Color SEGMENT_COLOR = sf::Color::Green;
+//the insides of the solid shapes, under their outline
+const sf::Uint8 FILL_ALPHA = 48;
+
+const float PI = 3.14159265359f;
+
+sf::Color fill(sf::Color color)
+{
+    color.a = FILL_ALPHA;
+    return color;
+}
+
+} // !namespace
+
+DebugRecorder::DebugRecorder() : b2Draw(), _frame(nullptr)
+{
+}
+
+void DebugRecorder::setFrame(DebugFrame& frame)
+{
+    _frame = &frame;
+    _frame->clear();
+}
+
+void DebugRecorder::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& /*color*/)
+{
+    addPolygon(vertices, vertexCount, false);
+}
+
+void DebugRecorder::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& /*color*/)
+{
+    addPolygon(vertices, vertexCount, true);
+}
+
+void DebugRecorder::DrawCircle(const b2Vec2& center, float32 radius, const b2Color& /*color*/)
+{
+    DebugFrame::Circle circle = { center, radius, false };
+    _frame->circles.push_back(circle);
+}
+
+void DebugRecorder::DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& /*axis*/, const b2Color& /*color*/)
+{
+    DebugFrame::Circle circle = { center, radius, true };
+    _frame->circles.push_back(circle);
+}
+
+void DebugRecorder::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& /*color*/)
+{
+    _frame->segments.push_back(p1);
+    _frame->segments.push_back(p2);
+}
+
+void DebugRecorder::DrawTransform(const b2Transform& /*xf*/)
+{
+}
+
+void DebugRecorder::addPolygon(const b2Vec2* vertices, int32 vertexCount, bool solid)
+{
+    _frame->vertices.insert(_frame->vertices.end(), vertices, vertices + vertexCount);
+    DebugFrame::Polygon polygon = { vertexCount, solid };
+    _frame->polygons.push_back(polygon);
+}
+
+DebugDraw::DebugDraw(sf::RenderTarget& tgt) : b2Draw(), _target(tgt), _lines(sf::Lines), _triangles(sf::Triangles)
+{
+    for (size_t segments = 8; segments <= 64; segments *= 2)
+    {
+        std::vector<sf::Vector2f> circle(segments);
+        for (size_t i = 0; i < segments; ++i)
+        {
+            const float angle = 2.0f * PI * i / segments;
+            circle[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+        _circles.push_back(circle);
+    }
+}
+
+void DebugDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& /*color*/)
+{
+    addOutline(vertices, vertexCount, POLYGON_COLOR);
+}
+
+void DebugDraw::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& /*color*/)
+{
+    addFill(vertices, vertexCount, fill(POLYGON_COLOR));
+    addOutline(vertices, vertexCount, POLYGON_COLOR);
+}
+
+void DebugDraw::DrawCircle(const b2Vec2& center, float32 radius, const b2Color& /*color*/)
+{
+    addCircle(center, radius, false);
+}
+
+void DebugDraw::DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& /*axis*/, const b2Color& /*color*/)
+{
+    addCircle(center, radius, true);
+}
+
+void DebugDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& /*color*/)
+{
+    _lines.append(sf::Vertex(sf::Vector2f(p1.x, p1.y), SEGMENT_COLOR));
+    _lines.append(sf::Vertex(sf::Vector2f(p2.x, p2.y), SEGMENT_COLOR));
+}
+
+void DebugDraw::DrawTransform(const b2Transform& /*xf*/)
+{
+}
+
+void DebugDraw::replay(const DebugFrame& frame)
+{
+    const b2Color color;
+    size_t first = 0;
+    for (size_t i = 0; i < frame.polygons.size(); ++i)
+    {
+        const DebugFrame::Polygon& polygon = frame.polygons[i];
+        if (polygon.solid)
+        {
+            DrawSolidPolygon(&frame.vertices[first], polygon.size, color);
+        }
+        else
+        {
+            DrawPolygon(&frame.vertices[first], polygon.size, color);
+        }
+        first += polygon.size;
+    }
+    for (size_t i = 0; i < frame.circles.size(); ++i)
+    {
+        addCircle(frame.circles[i].center, frame.circles[i].radius, frame.circles[i].solid);
+    }
+    for (size_t i = 0; i + 1 < frame.segments.size(); i += 2)
+    {
+        DrawSegment(frame.segments[i], frame.segments[i + 1], color);
+    }
+}
+
+void DebugDraw::flush()
+{
+    _stats = DebugDrawStats();
+    //the insides first, the outlines stay visible over them
+    if (_triangles.getVertexCount() > 0)
+    {
+        _target.draw(_triangles);
+        ++_stats.drawCalls;
+        _stats.vertices += _triangles.getVertexCount();
+    }
+    if (_lines.getVertexCount() > 0)
+    {
+        _target.draw(_lines);
+        ++_stats.drawCalls;
+        _stats.vertices += _lines.getVertexCount();
+    }
+    _triangles.clear();
+    _lines.clear();
+}
+
+const DebugDrawStats& DebugDraw::getStats() const
+{
+    return _stats;
+}
+
+void DebugDraw::addOutline(const b2Vec2* vertices, int32 vertexCount, const sf::Color& color)
+{
+    for (int32 i = 0, j = vertexCount - 1; i < vertexCount; j = i++)
+    {
+        _lines.append(sf::Vertex(sf::Vector2f(vertices[j].x, vertices[j].y), color));
+        _lines.append(sf::Vertex(sf::Vector2f(vertices[i].x, vertices[i].y), color));
+    }
+}
+
+void DebugDraw::addFill(const b2Vec2* vertices, int32 vertexCount, const sf::Color& color)
+{
+    //box2D polygons are convex, a fan covers them
+    const sf::Vector2f first(vertices[0].x, vertices[0].y);
+    for (int32 i = 1; i + 1 < vertexCount; ++i)
+    {
+        _triangles.append(sf::Vertex(first, color));
+        _triangles.append(sf::Vertex(sf::Vector2f(vertices[i].x, vertices[i].y), color));
+        _triangles.append(sf::Vertex(sf::Vector2f(vertices[i + 1].x, vertices[i + 1].y), color));
+    }
+}
+
+void DebugDraw::addCircle(const b2Vec2& center, float32 radius, bool solid)
+{
+    //a chord misses the circle by about radius * (pi / segments)^2 / 2, the first
+    //tessellation keeping it under half a pixel is used
+    size_t level = 0;
+    while (level + 1 < _circles.size() && _circles[level].size() < PI * std::sqrt(radius))
+    {
+        ++level;
+    }
+    const std::vector<sf::Vector2f>& unit = _circles[level];
+
+    const sf::Vector2f c(center.x, center.y);
+    const sf::Color inside = fill(CIRCLE_COLOR);
+    for (size_t i = 0, j = unit.size() - 1; i < unit.size(); j = i++)
+    {
+        const sf::Vector2f a = c + radius * unit[j];
+        const sf::Vector2f b = c + radius * unit[i];
+        _lines.append(sf::Vertex(a, CIRCLE_COLOR));
+        _lines.append(sf::Vertex(b, CIRCLE_COLOR));
+        if (solid)
+        {
+            _triangles.append(sf::Vertex(c, inside));
+            _triangles.append(sf::Vertex(a, inside));
+            _triangles.append(sf::Vertex(b, inside));
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef CHAINTEST_DEBUGDRAW_HPP
+#define CHAINTEST_DEBUGDRAW_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+#include <Box2D/Box2D.h>
+
+//the debug drawing of the world after a step, recorded by the simulation thread
+//and replayed by the render thread. The vectors keep their capacity between frames
+struct DebugFrame
+{
+    struct Polygon
+    {
+        int32 size;
+        bool solid;
+    };
+
+    struct Circle
+    {
+        b2Vec2 center;
+        float32 radius;
+        bool solid;
+    };
+
+    void clear()
+    {
+        vertices.clear();
+        polygons.clear();
+        circles.clear();
+        segments.clear();
+    }
+
+    //the vertices of every polygon one after the other, polygons splits them
+    std::vector<b2Vec2> vertices;
+    std::vector<Polygon> polygons;
+    std::vector<Circle> circles;
+    //two points per segment
+    std::vector<b2Vec2> segments;
+};
+
+//b2Draw that copies what the world draws into a DebugFrame
+class DebugRecorder : public b2Draw
+{
+    public:
+
+        DebugRecorder();
+
+        void setFrame(DebugFrame& frame);
+
+        void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color);
+        void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color);
+        void DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color);
+        void DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color);
+        void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color);
+        void DrawTransform(const b2Transform& xf);
+
+    private:
+
+        void addPolygon(const b2Vec2* vertices, int32 vertexCount, bool solid);
+
+        DebugFrame* _frame;
+};
+
+//what the last flush of a DebugDraw sent to its target
+struct DebugDrawStats
+{
+    DebugDrawStats() : drawCalls(0), vertices(0)
+    {
+    }
+
+    size_t drawCalls;
+    size_t vertices;
+};
+
+//b2Draw that batches everything it is given until flush(), the outlines in one line
+//array and the insides of the solid shapes in one triangle array, so a frame is at
+//most two draw calls. The arrays keep their capacity between frames, and circles
+//are copies of unit circles tessellated once, with more segments for larger circles
+class DebugDraw : public b2Draw
+{
+    public:
+
+        DebugDraw(sf::RenderTarget& tgt);
+
+        void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color);
+        void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color);
+        void DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color);
+        void DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color);
+        void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color);
+        void DrawTransform(const b2Transform& xf);
+
+        //batches a frame recorded by a DebugRecorder
+        void replay(const DebugFrame& frame);
+
+        //draws what was batched since the last flush and starts a new batch
+        void flush();
+
+        const DebugDrawStats& getStats() const;
+
+    private:
+
+        void addOutline(const b2Vec2* vertices, int32 vertexCount, const sf::Color& color);
+        void addFill(const b2Vec2* vertices, int32 vertexCount, const sf::Color& color);
+        void addCircle(const b2Vec2& center, float32 radius, bool solid);
+
+        sf::RenderTarget& _target;
+        sf::VertexArray _lines;
+        sf::VertexArray _triangles;
+        //unit circles with 8, 16, 32 and 64 segments
+        std::vector<std::vector<sf::Vector2f> > _circles;
+        DebugDrawStats _stats;
+};
+
+#endif // CHAINTEST_DEBUGDRAW_HPP
@@ -1,9 +1,18 @@
+#include <chrono>
 #include <iostream>
 #include <sstream>
+#include <string>
 
 #include <SFML/Graphics.hpp>
 #include <Box2D/Box2D.h>
 
+#include "debugdraw.hpp"
+#include "fixedstep.hpp"
+#include "profiler.hpp"
+#include "spscqueue.hpp"
+#include "triplebuffer.hpp"
+#include "worldprofile.hpp"
+
 #define DEGTORAD 0.0174532925199432957f
 #define RADTODEG 57.295779513082320876f
 
@@ -15,73 +24,24 @@ const double PI = 3.14159265359;
 
 } // !namespace
 
-class DebugDraw : public b2Draw
-  {
-  public:
-    DebugDraw(sf::RenderTarget& tgt) : b2Draw(), _target(tgt)
-    {
-    }
-
-    void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
-    {
-        sf::Color c(color.r, color.g, color.b, color.a);
-        sf::Vertex* vx = new sf::Vertex[vertexCount+1];
-        for(size_t i = 0; i < vertexCount; ++i)
-        {
-            vx[i].color = sf::Color::Red;
-            vx[i].position.x = vertices[i].x;
-            vx[i].position.y = vertices[i].y;
-        }
-        vx[vertexCount] = vx[0];
-
-        _target.draw(vx, vertexCount+1, sf::LinesStrip);
-
-        delete[] vx;
-    }
-
-    void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
-    {
-        DrawPolygon(vertices, vertexCount, color);
-    }
-
-    void DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color)
-    {
-        sf::CircleShape circle;
-        circle.setPosition(center.x, center.y);
-        circle.setRadius(radius);
-        circle.setOrigin(radius, radius);
-        circle.setOutlineColor(sf::Color(100,100,255));
-        circle.setOutlineThickness(1);
-        circle.setFillColor(sf::Color(0,0,0,0));
-
-        _target.draw(circle);
-    }
-
-    void DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color)
-    {
-        DrawCircle(center, radius, color);
-    }
-
-    void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
-    {
-        sf::Vertex vx[2];
-        vx[0].color = sf::Color::Green;
-        vx[0].position = {p1.x, p1.y};
-
-        vx[1].color = vx[0].color;
-        vx[1].position = {p2.x, p2.y};
-
-        _target.draw(vx, 2, sf::LinesStrip);
-    }
-
-    void DrawTransform(const b2Transform& xf)
-    {
-    }
-
-    private:
-        sf::RenderTarget& _target;
+//what the render thread knows of the world, written by the simulation thread
+struct Snapshot
+{
+    DebugFrame shapes;
+    //times of the steps of this snapshot and of the recording of its shapes, in ms
+    b2Profile profile;
+    float32 syncMs;
+};
+
+//input sent from the render thread to the simulation thread
+struct Command
+{
+    enum Type { MoveTo, MoveBy, Step };
 
-  };
+    Type type;
+    //where to put the circle, or how far to move it
+    b2Vec2 position;
+};
 
 void applyFriction(b2Body* body, float32 friction)
 {
@@ -96,12 +56,38 @@ void applyFriction(b2Body* body, float32 friction)
 }
 
 //font taken from http://www.fontspace.com/melifonts/sweet-cheeks
+//usage : Box2DChainTest [--profile file.csv]
+//--profile writes the time of every stage of every frame to a CSV file
+//F10 shows the profiler, F11 writes its last frames to profile.csv
 int main(int argc, char** argv)
 {
+    std::string profileFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!sandbox::parseProfileArgument(argc, argv, i, profileFile))
+        {
+            std::cerr << "usage : " << argv[0] << " [--profile file.csv]" << std::endl;
+            return 1;
+        }
+    }
+
     /** SFML STUFF **/
 
     sf::RenderWindow window(sf::VideoMode(WIDTH, HEIGHT), "Box2D test");
 
+    //the world stages are the steps of the snapshot taken in the frame, on the
+    //simulation thread, and the sync is the recording of its shapes there
+    sandbox::Profiler profiler;
+    const size_t eventStage = profiler.addStage("events", sf::Color(170, 170, 170));
+    sandbox::WorldStages worldStages(profiler);
+    const size_t syncStage = profiler.addStage("sync", sf::Color(60, 200, 90));
+    const size_t drawStage = profiler.addStage("draw", sf::Color(70, 130, 230));
+    sandbox::ProfilerOverlay overlay(profiler, sf::FloatRect(20.0f, 20.0f, 240.0f, 80.0f));
+    if (!profiler.startStream(profileFile))
+    {
+        return 1;
+    }
+
     b2Vec2 newton(0.0f, 5000);
 
     b2World world(newton);
@@ -178,13 +164,90 @@ int main(int argc, char** argv)
     b2Body* ground = world.CreateBody(&groundDef);
     ground->CreateFixture(&groundFixture);
 
+    //the world is only touched by the simulation thread from here, the render
+    //thread sends it commands and draws the frames it publishes
+    DebugRecorder recorder;
+    recorder.SetFlags(b2Draw::e_shapeBit | b2Draw::e_jointBit);
+    world.SetDebugDraw(&recorder);
+
+    sandbox::SpscQueue<Command, 64> commands;
+    sandbox::TripleBuffer<Snapshot> snapshots;
+
+    recorder.setFrame(snapshots.back().shapes);
+    world.DrawDebugData();
+    snapshots.back().profile = b2Profile();
+    snapshots.back().syncMs = 0.0f;
+    snapshots.publish();
+
+    //the steps between two snapshots, their profiles add up
+    b2Profile profile = b2Profile();
+    sandbox::FixedStepThread simulation(timeStep);
+    simulation.start([&]()
+    {
+        //F1 steps once more on top of the clock
+        int extraSteps = 0;
+        Command command;
+        while (commands.pop(command))
+        {
+            switch (command.type)
+            {
+                case Command::MoveTo:
+                    staticCircle->SetTransform(command.position, 0);
+                    break;
+                case Command::MoveBy:
+                    staticCircle->SetTransform(staticCircle->GetPosition() + command.position, 0);
+                    break;
+                case Command::Step:
+                    ++extraSteps;
+                    break;
+            }
+        }
+        return extraSteps;
+    },
+    [&]()
+    {
+        applyFriction(dynamicBody, friction);
+        applyFriction(dynamicBody2, friction);
+        applyFriction(dynamicBody3, friction);
+
+        world.Step(timeStep, velocityIterations, positionIterations);
+        sandbox::accumulate(profile, world.GetProfile());
+    },
+    [&](double)
+    {
+        Snapshot& snapshot = snapshots.back();
+        const sandbox::Profiler::Clock::time_point start = sandbox::Profiler::Clock::now();
+        recorder.setFrame(snapshot.shapes);
+        world.DrawDebugData();
+        snapshot.syncMs = std::chrono::duration<float32, std::milli>(sandbox::Profiler::Clock::now() - start).count();
+        snapshot.profile = profile;
+        snapshots.publish();
+        profile = b2Profile();
+    });
+
+    //a full queue drops the command, it holds far more than a step worth of input
+    auto send = [&commands](Command::Type type, const b2Vec2& position)
+    {
+        Command command;
+        command.type = type;
+        command.position = position;
+        commands.push(command);
+    };
+
     DebugDraw dbd(window);
-    dbd.SetFlags(b2Draw::e_shapeBit | b2Draw::e_jointBit);
-    world.SetDebugDraw(&dbd);
+    window.setVerticalSyncEnabled(true);
+
+    sf::Clock fpsTest;
+    size_t frameCount = 0;
 
     //the loop
     while (window.isOpen())
     {
+        //only the last mouse position of a frame is sent
+        bool mouseMoved = false;
+        b2Vec2 mouse;
+
+        sandbox::ScopedStage eventTime(profiler, eventStage);
         sf::Event event;
         while (window.pollEvent(event))
         {
@@ -194,7 +257,7 @@ int main(int argc, char** argv)
             }
             else if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased)
             {
-                bool down = (event.type == sf::Event::KeyPressed);
+                profiler.handleKey(event);
                 switch (event.key.code)
                 {
                     case sf::Keyboard::Escape:
@@ -202,31 +265,31 @@ int main(int argc, char** argv)
                         break;
 
                     case sf::Keyboard::F1:
-                        world.Step(timeStep, velocityIterations, positionIterations);
+                        send(Command::Step, b2Vec2(0, 0));
                         break;
 
                     case sf::Keyboard::F2:
-                        staticCircle->SetTransform({WIDTH/4, HEIGHT/4}, 0);
+                        send(Command::MoveTo, b2Vec2(WIDTH/4, HEIGHT/4));
                         break;
 
                     case sf::Keyboard::F3:
-                        staticCircle->SetTransform({WIDTH*3/4, HEIGHT/4}, 0);
+                        send(Command::MoveTo, b2Vec2(WIDTH*3/4, HEIGHT/4));
                         break;
 
                     case sf::Keyboard::D:
-                        staticCircle->SetTransform(staticCircle->GetPosition() + b2Vec2(10,0), 0);
+                        send(Command::MoveBy, b2Vec2(10,0));
                         break;
 
                     case sf::Keyboard::Q:
-                        staticCircle->SetTransform(staticCircle->GetPosition() + b2Vec2(-10,0), 0);
+                        send(Command::MoveBy, b2Vec2(-10,0));
                         break;
 
                     case sf::Keyboard::Z:
-                        staticCircle->SetTransform(staticCircle->GetPosition() + b2Vec2(0,-10), 0);
+                        send(Command::MoveBy, b2Vec2(0,-10));
                         break;
 
                     case sf::Keyboard::S:
-                        staticCircle->SetTransform(staticCircle->GetPosition() + b2Vec2(0,10), 0);
+                        send(Command::MoveBy, b2Vec2(0,10));
                         break;
 
                     default: break;
@@ -234,23 +297,44 @@ int main(int argc, char** argv)
             }
             else if(event.type == sf::Event::MouseMoved)
             {
-                staticCircle->SetTransform({event.mouseMove.x, event.mouseMove.y}, 0);
+                mouseMoved = true;
+                mouse.Set(event.mouseMove.x, event.mouseMove.y);
             }
         }
+        if (mouseMoved)
+        {
+            send(Command::MoveTo, mouse);
+        }
+        eventTime.stop();
 
-        applyFriction(dynamicBody, friction);
-        applyFriction(dynamicBody2, friction);
-        applyFriction(dynamicBody3, friction);
-
-        world.Step(timeStep, velocityIterations, positionIterations);
+        if (snapshots.update())
+        {
+            worldStages.add(snapshots.front().profile);
+            profiler.add(syncStage, snapshots.front().syncMs);
+        }
 
+        sandbox::ScopedStage drawTime(profiler, drawStage);
         window.clear();
-        world.DrawDebugData();
+        dbd.replay(snapshots.front().shapes);
+        dbd.flush();
+        drawTime.stop();
+        window.draw(overlay);
         window.display();
+        profiler.endFrame();
 
-        sf::sleep(sf::milliseconds(1000.0f/50.0f));
+        ++frameCount;
+        if (fpsTest.getElapsedTime().asMilliseconds() > 500)
+        {
+            std::cout << "fps : " << frameCount * 2 << std::endl;
+            const DebugDrawStats& stats = dbd.getStats();
+            std::cout << "draw calls : " << stats.drawCalls << ", vertices : " << stats.vertices << std::endl;
+            fpsTest.restart();
+            frameCount = 0;
+        }
     }
 
+    simulation.stop();
+
     world.DestroyJoint(rj);
     world.DestroyJoint(rj2);
     world.DestroyJoint(rj3);
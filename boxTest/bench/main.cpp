@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Box2D/Box2D.h>
+
+#include "bodysync.hpp"
+#include "scene.hpp"
+
+//headless benchmark of world.Step and of the body sync on the stress scenes of the
+//demo, in the same window sized world, borders and time step
+//usage : BoxTest-bench [--boxes n] [--frames n] [--density d] [--friction f]
+//                      [--sleep | --no-sleep] [--take-every n] [--seed n] [--out file.json]
+//without --boxes it runs 1k to 50k boxes, without --sleep or --no-sleep both
+//the reader of the sync takes one copy in n, as a render thread slower than the steps,
+//and the exit code is 2 if its bodies do not end where the world has them
+
+namespace
+{
+
+const float32 WIDTH = 640.0f;
+const float32 HEIGHT = 480.0f;
+const float32 TIME_STEP = 1.0f / 60.0f;
+const int32 VELOCITY_ITERATIONS = 6;
+const int32 POSITION_ITERATIONS = 2;
+
+struct Result
+{
+    size_t boxes;
+    bool allowSleep;
+    size_t frames;
+    double meanMs;
+    double p99Ms;
+    double maxMs;
+    double bodiesPerSec;
+    //copy of the bodies that moved around each step, as the demo does for its render thread
+    double syncMeanMs;
+    double syncedMean;
+    //bodies the reader has elsewhere than the world after the last frame
+    size_t mismatches;
+    //bodies still awake after the last frame
+    size_t awake;
+};
+
+//the transforms a render thread keeps, updated with the copies it takes
+struct Reader
+{
+    explicit Reader(size_t slots) : x(slots), y(slots), angle(slots)
+    {
+    }
+
+    void take(const BodyStates& states)
+    {
+        for (size_t i = 0; i < states.size(); ++i)
+        {
+            const uint32 slot = states.slots[i];
+            x[slot] = states.currentX[i];
+            y[slot] = states.currentY[i];
+            angle[slot] = states.currentAngle[i];
+        }
+    }
+
+    std::vector<float32> x;
+    std::vector<float32> y;
+    std::vector<float32> angle;
+};
+
+//steps a new scene frames times and times every step, the reader takes the copies
+//numbered by a multiple of takeEvery and the last one
+Result run(const SceneSettings& settings, size_t frames, size_t takeEvery)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    b2World world(b2Vec2(0.0f, 0.0f));
+    createWall(world, b2Vec2(WIDTH / 2.0f, 0.0f), b2Vec2(WIDTH / 2.0f, 10.0f));
+    createWall(world, b2Vec2(WIDTH, HEIGHT / 2.0f), b2Vec2(10.0f, HEIGHT / 2.0f));
+    createWall(world, b2Vec2(WIDTH / 2.0f, HEIGHT), b2Vec2(WIDTH / 2.0f, 10.0f));
+    createWall(world, b2Vec2(0.0f, HEIGHT / 2.0f), b2Vec2(10.0f, HEIGHT / 2.0f));
+    spawnBoxes(world, settings, b2Vec2(10.0f, 10.0f), b2Vec2(WIDTH - 10.0f, HEIGHT - 10.0f));
+
+    BodySync sync(world);
+    BodyStates states;
+
+    //the reader starts from the copy 0 as in the demo
+    Reader reader(sync.size());
+    sync.write(0, 0, states);
+    reader.take(states);
+    uint32 taken = 0;
+
+    std::vector<double> times(frames);
+    double total = 0.0;
+    double syncTotal = 0.0;
+    size_t synced = 0;
+    for (size_t i = 0; i < frames; ++i)
+    {
+        //the sync is timed on both sides of the step, and given the last copy the
+        //reader took as the demo does
+        const uint32 sequence = static_cast<uint32>(i + 1);
+        Clock::time_point begin = Clock::now();
+        sync.beforeStep(sequence);
+        Clock::time_point start = Clock::now();
+        world.Step(TIME_STEP, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+        Clock::time_point stepped = Clock::now();
+        sync.write(sequence, taken, states);
+        Clock::time_point end = Clock::now();
+
+        times[i] = std::chrono::duration<double, std::milli>(stepped - start).count();
+        total += times[i];
+        syncTotal += std::chrono::duration<double, std::milli>((start - begin) + (end - stepped)).count();
+        synced += states.size();
+
+        if (sequence % takeEvery == 0 || i + 1 == frames)
+        {
+            reader.take(states);
+            taken = sequence;
+        }
+    }
+
+    Result r;
+    r.boxes = settings.count;
+    r.allowSleep = settings.allowSleep;
+    r.frames = frames;
+    r.meanMs = frames > 0 ? total / frames : 0.0;
+    std::sort(times.begin(), times.end());
+    r.p99Ms = frames > 0 ? times[static_cast<size_t>(std::ceil(0.99 * frames)) - 1] : 0.0;
+    r.maxMs = frames > 0 ? times.back() : 0.0;
+    r.bodiesPerSec = total > 0.0 ? settings.count * frames / (total / 1000.0) : 0.0;
+    r.syncMeanMs = frames > 0 ? syncTotal / frames : 0.0;
+    r.syncedMean = frames > 0 ? static_cast<double>(synced) / frames : 0.0;
+    r.awake = 0;
+    r.mismatches = 0;
+    size_t slot = 0;
+    for (const b2Body* body = world.GetBodyList(); body; body = body->GetNext())
+    {
+        r.awake += body->GetType() == b2_dynamicBody && body->IsAwake();
+        if (!hasSlot(body))
+        {
+            continue;
+        }
+        r.mismatches += reader.x[slot] != body->GetPosition().x || reader.y[slot] != body->GetPosition().y
+            || reader.angle[slot] != body->GetAngle();
+        ++slot;
+    }
+    return r;
+}
+
+void writeJson(std::ostream& out, const SceneSettings& settings, size_t takeEvery, const std::vector<Result>& results)
+{
+    out << "{\n";
+    out << "  \"seed\": " << settings.seed << ",\n";
+    out << "  \"take_every\": " << takeEvery << ",\n";
+    out << "  \"density\": " << settings.density << ",\n";
+    out << "  \"friction\": " << settings.friction << ",\n";
+    out << "  \"time_step\": " << TIME_STEP << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& r = results[i];
+        out << "    {"
+            << "\"boxes\": " << r.boxes << ", "
+            << "\"sleep\": " << (r.allowSleep ? "true" : "false") << ", "
+            << "\"frames\": " << r.frames << ", "
+            << "\"step_mean_ms\": " << r.meanMs << ", "
+            << "\"step_p99_ms\": " << r.p99Ms << ", "
+            << "\"step_max_ms\": " << r.maxMs << ", "
+            << "\"bodies_per_sec\": " << r.bodiesPerSec << ", "
+            << "\"sync_mean_ms\": " << r.syncMeanMs << ", "
+            << "\"synced_mean\": " << r.syncedMean << ", "
+            << "\"awake\": " << r.awake << ", "
+            << "\"mismatches\": " << r.mismatches
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+} // !namespace
+
+int main(int argc, char** argv)
+{
+    SceneSettings settings;
+    size_t frames = 300;
+    size_t takeEvery = 3;
+    std::vector<size_t> counts;
+    std::vector<bool> sleeps;
+    std::string outFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--boxes") == 0 && i + 1 < argc)
+        {
+            counts.push_back(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            frames = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--density") == 0 && i + 1 < argc)
+        {
+            settings.density = static_cast<float32>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--friction") == 0 && i + 1 < argc)
+        {
+            settings.friction = static_cast<float32>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--sleep") == 0)
+        {
+            sleeps.push_back(true);
+        }
+        else if (std::strcmp(argv[i], "--no-sleep") == 0)
+        {
+            sleeps.push_back(false);
+        }
+        else if (std::strcmp(argv[i], "--take-every") == 0 && i + 1 < argc)
+        {
+            takeEvery = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            settings.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            outFile = argv[++i];
+        }
+        else
+        {
+            std::cerr << "usage : " << argv[0] << " [--boxes n] [--frames n] [--density d] [--friction f]"
+                << " [--sleep | --no-sleep] [--take-every n] [--seed n] [--out file.json]" << std::endl;
+            return 1;
+        }
+    }
+    if (counts.empty())
+    {
+        const size_t defaults[] = { 1000, 5000, 10000, 20000, 50000 };
+        counts.assign(defaults, defaults + sizeof(defaults) / sizeof(defaults[0]));
+    }
+    if (sleeps.empty())
+    {
+        sleeps.push_back(true);
+        sleeps.push_back(false);
+    }
+
+    std::vector<Result> results;
+    size_t mismatches = 0;
+    for (size_t c = 0; c < counts.size(); ++c)
+    {
+        for (size_t s = 0; s < sleeps.size(); ++s)
+        {
+            settings.count = counts[c];
+            settings.allowSleep = sleeps[s];
+            results.push_back(run(settings, frames, takeEvery));
+            //progress on stderr, the large scenes take a while
+            std::cerr << counts[c] << " boxes, sleep " << (sleeps[s] ? "on" : "off") << " : "
+                << results.back().meanMs << " ms per step" << std::endl;
+            mismatches += results.back().mismatches;
+            if (results.back().mismatches != 0)
+            {
+                std::cerr << counts[c] << " boxes : " << results.back().mismatches
+                    << " bodies of the reader differ from the world" << std::endl;
+            }
+        }
+    }
+
+    if (outFile.empty())
+    {
+        writeJson(std::cout, settings, takeEvery, results);
+    }
+    else
+    {
+        std::ofstream out(outFile.c_str());
+        if (!out)
+        {
+            std::cerr << "can not write " << outFile << std::endl;
+            return 1;
+        }
+        writeJson(out, settings, takeEvery, results);
+    }
+
+    return mismatches == 0 ? 0 : 2;
+}
@@ -0,0 +1,117 @@
+#include "bodysync.hpp"
+
+bool hasSlot(const b2Body* body)
+{
+    return body->GetType() != b2_staticBody;
+}
+
+int findSlot(b2World& world, const b2Body* body)
+{
+    int slot = 0;
+    for (b2Body* b = world.GetBodyList(); b; b = b->GetNext())
+    {
+        if (!hasSlot(b))
+        {
+            continue;
+        }
+        if (b == body)
+        {
+            return slot;
+        }
+        ++slot;
+    }
+    return -1;
+}
+
+BodySync::BodySync(b2World& world) : _world(world)
+{
+    for (b2Body* body = world.GetBodyList(); body; body = body->GetNext())
+    {
+        if (!hasSlot(body))
+        {
+            continue;
+        }
+        const b2Vec2& position = body->GetPosition();
+        _previousX.push_back(position.x);
+        _previousY.push_back(position.y);
+        _previousAngle.push_back(body->GetAngle());
+        _lastAwake.push_back(0);
+    }
+    _currentX = _previousX;
+    _currentY = _previousY;
+    _currentAngle = _previousAngle;
+}
+
+size_t BodySync::size() const
+{
+    return _lastAwake.size();
+}
+
+void BodySync::beforeStep(uint32 sequence)
+{
+    size_t slot = 0;
+    for (b2Body* body = _world.GetBodyList(); body; body = body->GetNext())
+    {
+        if (!hasSlot(body))
+        {
+            continue;
+        }
+        if (body->IsAwake())
+        {
+            const b2Vec2& position = body->GetPosition();
+            _previousX[slot] = position.x;
+            _previousY[slot] = position.y;
+            _previousAngle[slot] = body->GetAngle();
+            _lastAwake[slot] = sequence;
+        }
+        ++slot;
+    }
+}
+
+void BodySync::write(uint32 sequence, uint32 since, BodyStates& out)
+{
+    out.resize(size());
+    size_t count = 0;
+    size_t slot = 0;
+    for (b2Body* body = _world.GetBodyList(); body; body = body->GetNext())
+    {
+        if (!hasSlot(body))
+        {
+            continue;
+        }
+        //awake now, or fell asleep during one of the steps
+        const bool awake = body->IsAwake();
+        if (awake || _lastAwake[slot] == sequence)
+        {
+            const b2Vec2& position = body->GetPosition();
+            _currentX[slot] = position.x;
+            _currentY[slot] = position.y;
+            _currentAngle[slot] = body->GetAngle();
+            _lastAwake[slot] = sequence;
+        }
+
+        if (_lastAwake[slot] >= since)
+        {
+            //a body that did not move in this copy is drawn where it stopped
+            const bool moved = _lastAwake[slot] == sequence;
+            out.slots[count] = static_cast<uint32>(slot);
+            out.previousX[count] = moved ? _previousX[slot] : _currentX[slot];
+            out.previousY[count] = moved ? _previousY[slot] : _currentY[slot];
+            out.previousAngle[count] = moved ? _previousAngle[slot] : _currentAngle[slot];
+            out.currentX[count] = _currentX[slot];
+            out.currentY[count] = _currentY[slot];
+            out.currentAngle[count] = _currentAngle[slot];
+            ++count;
+        }
+
+        //a body woken up by a contact during a step starts from where it slept
+        if (!awake)
+        {
+            _previousX[slot] = _currentX[slot];
+            _previousY[slot] = _currentY[slot];
+            _previousAngle[slot] = _currentAngle[slot];
+        }
+        ++slot;
+    }
+    out.count = count;
+}
@@ -0,0 +1,86 @@
+#ifndef BOXTEST_BODYSYNC_HPP
+#define BOXTEST_BODYSYNC_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <Box2D/Box2D.h>
+
+//transforms of the bodies that moved, as a structure of arrays
+//entry i < count is the body in slot slots[i], before and after the last step
+//the arrays have room for every slot and only the first count entries are used,
+//so they are written without ever growing
+struct BodyStates
+{
+    BodyStates() : count(0)
+    {
+    }
+
+    void resize(size_t slotCount)
+    {
+        slots.resize(slotCount);
+        previousX.resize(slotCount);
+        previousY.resize(slotCount);
+        previousAngle.resize(slotCount);
+        currentX.resize(slotCount);
+        currentY.resize(slotCount);
+        currentAngle.resize(slotCount);
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    size_t count;
+
+    std::vector<uint32> slots;
+    std::vector<float32> previousX;
+    std::vector<float32> previousY;
+    std::vector<float32> previousAngle;
+    std::vector<float32> currentX;
+    std::vector<float32> currentY;
+    std::vector<float32> currentAngle;
+};
+
+//the non static bodies of a world are numbered in the order of world.GetBodyList(),
+//this is their slot. Bodies must not be created or destroyed once slots are used
+bool hasSlot(const b2Body* body);
+//slot of a body, or -1 for a static body or a body of another world
+int findSlot(b2World& world, const b2Body* body);
+
+//copies the transforms of the bodies out of the world, for a reader on another thread
+//bodies asleep are skipped, their last transform stays where the reader put it.
+//Every copy is numbered, and the reader says which copy it took last so the next
+//ones hold every body that moved since, even if the reader skips some copies
+class BodySync
+{
+    public:
+
+        explicit BodySync(b2World& world);
+
+        //number of slots
+        size_t size() const;
+
+        //before each step of the copy numbered sequence, keeps where the awake bodies are
+        void beforeStep(uint32 sequence);
+
+        //after the steps of the copy numbered sequence, writes in out every body that
+        //was awake in the copies since to sequence, both included. Its cost is one walk
+        //of the body list, plus a copy per body that moved
+        void write(uint32 sequence, uint32 since, BodyStates& out);
+
+    private:
+
+        b2World& _world;
+        std::vector<float32> _previousX;
+        std::vector<float32> _previousY;
+        std::vector<float32> _previousAngle;
+        std::vector<float32> _currentX;
+        std::vector<float32> _currentY;
+        std::vector<float32> _currentAngle;
+        //number of the last copy each body was awake in
+        std::vector<uint32> _lastAwake;
+};
+
+#endif // BOXTEST_BODYSYNC_HPP
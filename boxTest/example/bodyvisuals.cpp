@@ -0,0 +1,69 @@
+#include "bodyvisuals.hpp"
+
+#include <cmath>
+
+BodyVisuals::BodyVisuals(b2World& world, const sf::Color& color) : _vertices(sf::Triangles)
+{
+    _first.push_back(0);
+    for (b2Body* body = world.GetBodyList(); body; body = body->GetNext())
+    {
+        if (!hasSlot(body))
+        {
+            continue;
+        }
+        for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        {
+            if (fixture->GetType() != b2Shape::e_polygon)
+            {
+                continue;
+            }
+            const b2PolygonShape* polygon = static_cast<const b2PolygonShape*>(fixture->GetShape());
+            for (int32 i = 1; i + 1 < polygon->m_count; ++i)
+            {
+                _local.push_back(polygon->m_vertices[0]);
+                _local.push_back(polygon->m_vertices[i]);
+                _local.push_back(polygon->m_vertices[i + 1]);
+            }
+        }
+        _first.push_back(_local.size());
+    }
+
+    _vertices.resize(_local.size());
+    for (size_t i = 0; i < _local.size(); ++i)
+    {
+        _vertices[i].color = color;
+    }
+}
+
+void BodyVisuals::setColor(size_t slot, const sf::Color& color)
+{
+    for (size_t i = _first[slot]; i < _first[slot + 1]; ++i)
+    {
+        _vertices[i].color = color;
+    }
+}
+
+void BodyVisuals::update(const BodyStates& states, float32 alpha)
+{
+    const float32 beta = 1.0f - alpha;
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        const float32 x = beta * states.previousX[i] + alpha * states.currentX[i];
+        const float32 y = beta * states.previousY[i] + alpha * states.currentY[i];
+        const float32 angle = beta * states.previousAngle[i] + alpha * states.currentAngle[i];
+        const float32 c = std::cos(angle);
+        const float32 s = std::sin(angle);
+
+        const size_t slot = states.slots[i];
+        for (size_t v = _first[slot]; v < _first[slot + 1]; ++v)
+        {
+            const b2Vec2& p = _local[v];
+            _vertices[v].position = sf::Vector2f(x + c * p.x - s * p.y, y + s * p.x + c * p.y);
+        }
+    }
+}
+
+void BodyVisuals::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    target.draw(_vertices, states);
+}
@@ -0,0 +1,40 @@
+#ifndef BOXTEST_BODYVISUALS_HPP
+#define BOXTEST_BODYVISUALS_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+#include <Box2D/Box2D.h>
+
+#include "bodysync.hpp"
+
+//the polygons of the bodies with a slot, in one vertex array drawn with a single call
+//each polygon is a fan of triangles. Only the bodies given to update() are written,
+//the others keep the vertices of their last transform
+class BodyVisuals : public sf::Drawable
+{
+    public:
+
+        //reads the shapes of the bodies, call it before the world goes to another thread
+        BodyVisuals(b2World& world, const sf::Color& color);
+
+        void setColor(size_t slot, const sf::Color& color);
+
+        //moves the bodies in states, alpha goes from their previous transform (0)
+        //to their current one (1)
+        void update(const BodyStates& states, float32 alpha);
+
+    protected:
+
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+    private:
+
+        //the triangles of every slot in body coordinates, _first[slot] to _first[slot + 1]
+        std::vector<b2Vec2> _local;
+        std::vector<size_t> _first;
+        sf::VertexArray _vertices;
+};
+
+#endif // BOXTEST_BODYVISUALS_HPP
@@ -1,19 +1,66 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <SFML/Graphics.hpp>
 #include <Box2D/Box2D.h>
 
+#include "bodysync.hpp"
+#include "bodyvisuals.hpp"
+#include "scene.hpp"
+#include "fixedstep.hpp"
+#include "profiler.hpp"
+#include "spscqueue.hpp"
+#include "triplebuffer.hpp"
+#include "worldprofile.hpp"
+
 namespace {
 
 const unsigned WIDTH = 640;
 const unsigned HEIGHT = 480;
 const double PI = 3.14159265359;
 
+//the physics always advances by this step, whatever the frame rate
+const float32 TIME_STEP = 1.0f / 60.0f;
+
 } // !namespace
 
 enum Direction { UP, LEFT, DOWN, RIGHT, D_SIZE };
 
+//what the render thread knows of the world, written by the simulation thread
+//bodies are the ones that moved since the last snapshot the render thread took,
+//before and after the last step. time is when the last step ends on the shared clock
+struct Snapshot
+{
+    BodyStates bodies;
+    uint32 sequence;
+    double time;
+    //times of the steps of this snapshot and of the copy of its bodies, in ms
+    b2Profile profile;
+    float32 syncMs;
+};
+
+//input sent from the render thread to the simulation thread
+struct Command
+{
+    enum Type { Move, Impulse };
+
+    Type type;
+    int box;
+    //Move holds or releases a direction
+    Direction direction;
+    bool down;
+    //Impulse is applied before the next step
+    b2Vec2 impulse;
+};
+
 void applyFriction(b2Body* body, float32 friction)
 {
     b2Vec2 vel = body->GetLinearVelocity();
@@ -80,16 +127,6 @@ class PhysicBox : public sf::Drawable
             }
         }
 
-        void update()
-        {
-            if (!_body) return;
-            b2Vec2 position = _body->GetPosition();
-            float32 angle = _body->GetAngle() * 180.0f / PI*1.0f;
-
-            _bodyVisual.setRotation(angle);
-            _bodyVisual.setPosition(position.x, position.y);
-        }
-
         void setColor(const sf::Color& c)
         {
             _bodyVisual.setFillColor(c);
@@ -140,19 +177,66 @@ class PhysicBox : public sf::Drawable
 };
 
 //font taken from http://www.fontspace.com/melifonts/sweet-cheeks
+//usage : BoxTest [--boxes n] [--density d] [--friction f] [--no-sleep] [--seed n] [--profile file.csv]
+//--boxes fills the bottom of the window with a stress scene of n more boxes
+//--profile writes the time of every stage of every frame to a CSV file
+//F10 shows the profiler, F11 writes its last frames to profile.csv
 int main(int argc, char** argv)
 {
+    SceneSettings scene;
+    scene.count = 0;
+    std::string profileFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--boxes") == 0 && i + 1 < argc)
+        {
+            scene.count = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--density") == 0 && i + 1 < argc)
+        {
+            scene.density = static_cast<float32>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--friction") == 0 && i + 1 < argc)
+        {
+            scene.friction = static_cast<float32>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--no-sleep") == 0)
+        {
+            scene.allowSleep = false;
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            scene.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!sandbox::parseProfileArgument(argc, argv, i, profileFile))
+        {
+            std::cerr << "usage : " << argv[0] << " [--boxes n] [--density d] [--friction f] [--no-sleep] [--seed n] [--profile file.csv]" << std::endl;
+            return 1;
+        }
+    }
 
     /** SFML STUFF **/
 
     sf::RenderWindow window(sf::VideoMode(WIDTH, HEIGHT), "Box2D test");
+    window.setVerticalSyncEnabled(true);
+
+    //the world stages are the steps of the snapshot taken in the frame, on the
+    //simulation thread, and the sync is its copy there plus the vertex update here
+    sandbox::Profiler profiler;
+    const size_t eventStage = profiler.addStage("events", sf::Color(170, 170, 170));
+    sandbox::WorldStages worldStages(profiler);
+    const size_t syncStage = profiler.addStage("sync", sf::Color(60, 200, 90));
+    const size_t drawStage = profiler.addStage("draw", sf::Color(70, 130, 230));
+    sandbox::ProfilerOverlay overlay(profiler, sf::FloatRect(20.0f, 20.0f, 240.0f, 80.0f));
+    if (!profiler.startStream(profileFile))
+    {
+        return 1;
+    }
 
     b2Vec2 newton(0.0f, 0.0f);
 
     b2World world(newton);
 
-    float32 timeStep = 1.0f / 60.0f;
-
     int32 velocityIterations = 6;
     int32 positionIterations = 2;
 
@@ -175,7 +259,6 @@ int main(int argc, char** argv)
     }
 
     PhysicBox box1;
-    box1.setColor(sf::Color::Red);
     box1.initBox({ WIDTH / 2.0f, 50.0f }, { 30.0f, 10.0f });
     box1.initPhysics(world, 0.1f, 0.3f);
     //box1._body->SetAngularVelocity(3.14159f);
@@ -183,18 +266,113 @@ int main(int argc, char** argv)
     //box1._body->ApplyLinearImpulseToCenter({ 0.0f, 50000.0f }, true);
 
     PhysicBox box2;
-    box2.setColor(sf::Color::Green);
     box2.initBox({ WIDTH / 2.0f - 150, 100.0f }, { 25.0f, 25.0f });
     box2.initPhysics(world, 0.1f, 0.3);
     //box2._body->SetAngularVelocity(3.14159f);
     //box2._body->SetLinearVelocity({ 100.0f, -50.0f });
     //box2._body->ApplyLinearImpulseToCenter({ 50000.0f, 0.0f }, true);
 
+    //under the two boxes, inside the borders
+    spawnBoxes(world, scene, b2Vec2(10.0f, 130.0f), b2Vec2(WIDTH - 10.0f, HEIGHT - 10.0f));
+
     float32 friction = 1000.0f;
 
+    //the commands name the boxes by their index here
+    PhysicBox* controlled[] = { &box1, &box2 };
+
+    //every dynamic box is drawn by one vertex array, the borders do not move and
+    //keep their own shapes
+    BodyVisuals visuals(world, { 70, 110, 200 });
+    visuals.setColor(findSlot(world, box1._body), sf::Color::Red);
+    visuals.setColor(findSlot(world, box2._body), sf::Color::Green);
+
+    //the world is only touched by the simulation thread from here, the render
+    //thread sends it commands and reads the snapshots it publishes
+    sandbox::SpscQueue<Command, 64> commands;
+    sandbox::TripleBuffer<Snapshot> snapshots;
+    //sequence of the last snapshot the render thread took
+    std::atomic<uint32> taken(0);
+
+    //the first snapshot holds every body
+    BodySync sync(world);
+    sync.write(0, 0, snapshots.back().bodies);
+    snapshots.back().sequence = 0;
+    snapshots.back().time = 0.0;
+    snapshots.back().profile = b2Profile();
+    snapshots.back().syncMs = 0.0f;
+    snapshots.publish();
+
+    //the steps between two snapshots, their profiles add up
+    uint32 sequence = 1;
+    b2Profile profile = b2Profile();
+    sandbox::FixedStepThread simulation(TIME_STEP);
+    simulation.start([&]()
+    {
+        Command command;
+        while (commands.pop(command))
+        {
+            PhysicBox& box = *controlled[command.box];
+            if (command.type == Command::Move)
+            {
+                box._directions[command.direction] = command.down;
+            }
+            else
+            {
+                box._body->ApplyLinearImpulseToCenter(command.impulse, true);
+            }
+        }
+        return 0;
+    },
+    [&]()
+    {
+        sync.beforeStep(sequence);
+        //the forces are cleared by every step
+        box1.applyForces(friction);
+        box2.applyForces(friction);
+
+        world.Step(TIME_STEP, velocityIterations, positionIterations);
+        sandbox::accumulate(profile, world.GetProfile());
+    },
+    [&](double time)
+    {
+        Snapshot& snapshot = snapshots.back();
+        const sandbox::Profiler::Clock::time_point start = sandbox::Profiler::Clock::now();
+        sync.write(sequence, taken.load(std::memory_order_acquire), snapshot.bodies);
+        snapshot.syncMs = std::chrono::duration<float32, std::milli>(sandbox::Profiler::Clock::now() - start).count();
+        snapshot.profile = profile;
+        snapshot.sequence = sequence++;
+        snapshot.time = time;
+        snapshots.publish();
+        profile = b2Profile();
+    });
+
+    //a full queue drops the command, it holds far more than a step worth of input
+    auto send = [&commands](const Command& command)
+    {
+        commands.push(command);
+    };
+    auto move = [&send](Direction direction, bool down)
+    {
+        Command command;
+        command.type = Command::Move;
+        command.box = 0;
+        command.direction = direction;
+        command.down = down;
+        send(command);
+    };
+    auto impulse = [&send](const b2Vec2& impulse)
+    {
+        Command command;
+        command.type = Command::Impulse;
+        command.box = 1;
+        command.impulse = impulse;
+        send(command);
+    };
+
     //the loop
     while (window.isOpen())
     {
+        sandbox::ScopedStage eventTime(profiler, eventStage);
         sf::Event event;
         while (window.pollEvent(event))
         {
@@ -204,6 +382,7 @@ int main(int argc, char** argv)
             }
             else if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased)
             {
+                profiler.handleKey(event);
                 bool down = (event.type == sf::Event::KeyPressed);
                 switch (event.key.code)
                 {
@@ -212,56 +391,65 @@ int main(int argc, char** argv)
                         break;
                     case sf::Keyboard::Z:
                         //box1._body->ApplyLinearImpulseToCenter(b2Vec2(0.0f, -500.0f), true);
-                        box1._directions[UP] = down;
+                        move(UP, down);
                         break;
                     case sf::Keyboard::S:
                         //box1._body->ApplyLinearImpulseToCenter(b2Vec2(0.0f, 500.0f), true);
-                        box1._directions[DOWN] = down;
+                        move(DOWN, down);
                         break;
                     case sf::Keyboard::Q:
                         //box1._body->ApplyLinearImpulseToCenter(b2Vec2(-500.0f, 0.0f), true);
-                        box1._directions[LEFT] = down;
+                        move(LEFT, down);
                         break;
                     case sf::Keyboard::D:
                         //box1._body->ApplyLinearImpulseToCenter(b2Vec2(500.0f, 0.0f), true);
-                        box1._directions[RIGHT] = down;
+                        move(RIGHT, down);
                         break;
                     case sf::Keyboard::Up:
-                        box2._body->ApplyLinearImpulseToCenter(b2Vec2(0.0f, -500.0f), true);
+                        impulse(b2Vec2(0.0f, -500.0f));
                         break;
                     case sf::Keyboard::Down:
-                        box2._body->ApplyLinearImpulseToCenter(b2Vec2(0.0f, 500.0f), true);
+                        impulse(b2Vec2(0.0f, 500.0f));
                         break;
                     case sf::Keyboard::Left:
-                        box2._body->ApplyLinearImpulseToCenter(b2Vec2(-500.0f, 0.0f), true);
+                        impulse(b2Vec2(-500.0f, 0.0f));
                         break;
                     case sf::Keyboard::Right:
-                        box2._body->ApplyLinearImpulseToCenter(b2Vec2(500.0f, 0.0f), true);
+                        impulse(b2Vec2(500.0f, 0.0f));
                         break;
                     default: break;
                 }
             }
         }
+        eventTime.stop();
 
-        //apply friction
-        box1.applyForces(friction);
-        box2.applyForces(friction);
-
-        world.Step(timeStep, velocityIterations, positionIterations);
-
-        box1.update();
-        box2.update();
+        //the snapshot lags a step behind, it is drawn between its two states
+        //only the bodies that moved since the last one are written
+        sandbox::ScopedStage syncTime(profiler, syncStage);
+        if (snapshots.update())
+        {
+            taken.store(snapshots.front().sequence, std::memory_order_release);
+            worldStages.add(snapshots.front().profile);
+            profiler.add(syncStage, snapshots.front().syncMs);
+        }
+        const Snapshot& snapshot = snapshots.front();
+        const double elapsed = simulation.now() - snapshot.time;
+        const float32 alpha = static_cast<float32>(std::min(1.0, elapsed / TIME_STEP));
+        visuals.update(snapshot.bodies, alpha);
+        syncTime.stop();
 
+        sandbox::ScopedStage drawTime(profiler, drawStage);
         window.clear({ 127, 127, 127 });
         //window.draw(ground);
         for (int i = 0; i < 4; ++i) window.draw(borders[i]);
-        window.draw(box1);
-        window.draw(box2);
+        window.draw(visuals);
+        drawTime.stop();
+        window.draw(overlay);
         window.display();
-
-        sf::sleep(sf::milliseconds(16));
+        profiler.endFrame();
     }
 
+    simulation.stop();
 
     return 0;
 }
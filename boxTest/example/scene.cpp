@@ -0,0 +1,72 @@
+#include "scene.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+std::vector<SpawnedBox> spawnBoxes(b2World& world, const SceneSettings& settings, const b2Vec2& lower, const b2Vec2& upper)
+{
+    std::vector<SpawnedBox> boxes;
+    if (settings.count == 0)
+    {
+        return boxes;
+    }
+    boxes.reserve(settings.count);
+
+    world.SetAllowSleeping(settings.allowSleep);
+
+    //square cells, as many columns as keeps the grid in the rectangle
+    const float32 width = upper.x - lower.x;
+    const float32 height = upper.y - lower.y;
+    const size_t columns = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(settings.count * width / height))));
+    const size_t rows = (settings.count + columns - 1) / columns;
+    const float32 cell = std::min(width / columns, height / rows);
+
+    //a half side of at most 0.35 cell keeps the half diagonal under half a cell
+    std::mt19937 rng(settings.seed);
+    std::uniform_real_distribution<float32> side(0.2f * cell, 0.35f * cell);
+    std::uniform_real_distribution<float32> unit(0.0f, 1.0f);
+
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_dynamicBody;
+    bodyDef.allowSleep = settings.allowSleep;
+    bodyDef.linearDamping = settings.damping;
+    bodyDef.angularDamping = settings.damping;
+
+    b2PolygonShape shape;
+    b2FixtureDef fixture;
+    fixture.shape = &shape;
+    fixture.density = settings.density;
+    fixture.friction = settings.friction;
+    fixture.restitution = settings.restitution;
+
+    for (size_t i = 0; i < settings.count; ++i)
+    {
+        const float32 direction = 2.0f * b2_pi * unit(rng);
+        bodyDef.position.Set(lower.x + (i % columns + 0.5f) * cell, lower.y + (i / columns + 0.5f) * cell);
+        bodyDef.angle = 2.0f * b2_pi * unit(rng);
+        bodyDef.linearVelocity.Set(settings.speed * std::cos(direction), settings.speed * std::sin(direction));
+
+        SpawnedBox box;
+        box.halfSize.Set(side(rng), side(rng));
+        shape.SetAsBox(box.halfSize.x, box.halfSize.y);
+        box.body = world.CreateBody(&bodyDef);
+        box.body->CreateFixture(&fixture);
+        boxes.push_back(box);
+    }
+    return boxes;
+}
+
+b2Body* createWall(b2World& world, const b2Vec2& center, const b2Vec2& halfSize)
+{
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_staticBody;
+    bodyDef.position = center;
+
+    b2PolygonShape shape;
+    shape.SetAsBox(halfSize.x, halfSize.y);
+
+    b2Body* body = world.CreateBody(&bodyDef);
+    body->CreateFixture(&shape, 0.0f);
+    return body;
+}
@@ -0,0 +1,46 @@
+#ifndef BOXTEST_SCENE_HPP
+#define BOXTEST_SCENE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <Box2D/Box2D.h>
+
+//how the boxes of a stress scene are made
+struct SceneSettings
+{
+    SceneSettings() : count(1000), density(0.1f), friction(0.3f), restitution(0.8f),
+        speed(100.0f), damping(0.5f), allowSleep(true), seed(1)
+    {
+    }
+
+    size_t count;
+    //fixture density, friction and restitution of every box
+    float32 density;
+    float32 friction;
+    float32 restitution;
+    //boxes start with a random velocity of this length, the world has no gravity
+    float32 speed;
+    //linear and angular damping, lets the boxes settle down and fall asleep
+    float32 damping;
+    //applied to the world and to every box
+    bool allowSleep;
+    unsigned seed;
+};
+
+struct SpawnedBox
+{
+    b2Body* body;
+    b2Vec2 halfSize;
+};
+
+//fills the rectangle lower>upper with settings.count dynamic boxes, one per cell of a
+//grid covering it. The boxes are small enough to never overlap whatever their angle,
+//so the scene starts without contacts to solve. Their size, angle and velocity come
+//from settings.seed, the same settings always give the same scene
+std::vector<SpawnedBox> spawnBoxes(b2World& world, const SceneSettings& settings, const b2Vec2& lower, const b2Vec2& upper);
+
+//static box, for the borders around a scene
+b2Body* createWall(b2World& world, const b2Vec2& center, const b2Vec2& halfSize);
+
+#endif // BOXTEST_SCENE_HPP
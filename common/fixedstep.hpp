@@ -0,0 +1,108 @@
+#ifndef SANDBOX_FIXEDSTEP_HPP
+#define SANDBOX_FIXEDSTEP_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace sandbox
+{
+
+//runs a simulation on its own thread, always advanced by the same time step
+//whatever the frame rate of the render thread. Each turn the thread takes the
+//commands of the render thread, runs the steps due on the clock, publishes a
+//snapshot if it stepped, and sleeps until the next step is due if it did not
+class FixedStepThread
+{
+    public:
+
+        //when the simulation is late by more than maxCatchUpSteps steps it drops the
+        //extra time instead of stepping more, or slow steps would make it even later
+        explicit FixedStepThread(double timeStep, int maxCatchUpSteps = 5) :
+            _timeStep(timeStep), _maxCatchUpSteps(maxCatchUpSteps), _start(Clock::now()), _running(false)
+        {
+        }
+
+        ~FixedStepThread()
+        {
+            stop();
+        }
+
+        //seconds since construction, the clock the steps follow, read by both threads
+        double now() const
+        {
+            return std::chrono::duration<double>(Clock::now() - _start).count();
+        }
+
+        //poll() takes the commands sent since the last turn and returns a number of steps
+        //to run at once on top of the clock, step() advances the world by the time step,
+        //and snapshot(time) publishes it, time being when its last step ends on now()
+        //the callbacks are only called on the simulation thread
+        template <typename Poll, typename Step, typename Snapshot>
+        void start(Poll poll, Step step, Snapshot snapshot)
+        {
+            stop();
+            _running.store(true, std::memory_order_relaxed);
+            _thread = std::thread([this, poll, step, snapshot]() mutable
+            {
+                //time up to which the world has been stepped, in double like now()
+                //after a day a float count of seconds is too coarse to add a step to
+                double simulated = 0.0;
+                while (_running.load(std::memory_order_relaxed))
+                {
+                    const int extraSteps = poll();
+                    for (int i = 0; i < extraSteps; ++i)
+                    {
+                        step();
+                    }
+
+                    const double now = this->now();
+                    int steps = 0;
+                    while (simulated + _timeStep <= now && steps < _maxCatchUpSteps)
+                    {
+                        step();
+                        simulated += _timeStep;
+                        ++steps;
+                    }
+                    if (steps == _maxCatchUpSteps)
+                    {
+                        simulated = now - std::fmod(now - simulated, _timeStep);
+                    }
+
+                    if (steps > 0 || extraSteps > 0)
+                    {
+                        snapshot(simulated);
+                    }
+                    else
+                    {
+                        std::this_thread::sleep_for(std::chrono::duration<double>(simulated + _timeStep - now));
+                    }
+                }
+            });
+        }
+
+        //lets the turn in progress end and joins the thread
+        void stop()
+        {
+            _running.store(false, std::memory_order_relaxed);
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+        }
+
+    private:
+
+        typedef std::chrono::steady_clock Clock;
+
+        const double _timeStep;
+        const int _maxCatchUpSteps;
+        const Clock::time_point _start;
+        std::atomic<bool> _running;
+        std::thread _thread;
+};
+
+} // !namespace sandbox
+
+#endif // SANDBOX_FIXEDSTEP_HPP
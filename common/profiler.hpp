@@ -0,0 +1,371 @@
+#ifndef SANDBOX_PROFILER_HPP
+#define SANDBOX_PROFILER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace sandbox
+{
+
+//time spent each frame in a few named stages of a demo
+//stages are timed with ScopedStage or given with add(), and endFrame() closes the
+//frame: it goes in a ring buffer of the last frames, drawn by ProfilerOverlay, and
+//in the CSV stream if one is open. While disabled and without a stream nothing is
+//timed or kept, a ScopedStage costs a test of a bool
+class Profiler
+{
+    public:
+
+        typedef std::chrono::steady_clock Clock;
+
+        explicit Profiler(size_t history = 240) : _history(history), _next(0), _count(0), _enabled(false), _frame(0)
+        {
+        }
+
+        //stages are declared before the first frame, returns the index of the stage
+        size_t addStage(const std::string& name, const sf::Color& color)
+        {
+            _names.push_back(name);
+            _colors.push_back(color);
+            _current.push_back(0.0);
+            _times.assign(_history * _names.size(), 0.0f);
+            return _names.size() - 1;
+        }
+
+        void setEnabled(bool enabled)
+        {
+            _enabled = enabled;
+        }
+
+        //true if the frames are recorded, when enabled or streamed
+        bool isEnabled() const
+        {
+            return _enabled || _csv.is_open();
+        }
+
+        //true if enabled, ProfilerOverlay is only drawn then
+        bool isShown() const
+        {
+            return _enabled;
+        }
+
+        //the keys every demo gives the profiler, F10 shows or hides it and writes
+        //its legend, F11 writes its last frames to profile.csv
+        //returns true if the event is one of these keys, pressed or released
+        bool handleKey(const sf::Event& event)
+        {
+            if ((event.type != sf::Event::KeyPressed && event.type != sf::Event::KeyReleased)
+                || (event.key.code != sf::Keyboard::F10 && event.key.code != sf::Keyboard::F11))
+            {
+                return false;
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F10)
+            {
+                setEnabled(!_enabled);
+                if (_enabled)
+                {
+                    writeLegend(std::cout);
+                }
+            }
+            else if (event.type == sf::Event::KeyPressed)
+            {
+                std::ofstream out("profile.csv");
+                writeCsv(out);
+            }
+            return true;
+        }
+
+        //adds ms to a stage of the current frame
+        void add(size_t stage, double ms)
+        {
+            if (isEnabled())
+            {
+                _current[stage] += ms;
+            }
+        }
+
+        //closes the current frame and starts the next one
+        void endFrame()
+        {
+            if (!isEnabled())
+            {
+                return;
+            }
+            for (size_t s = 0; s < _current.size(); ++s)
+            {
+                _times[_next * _current.size() + s] = static_cast<float>(_current[s]);
+            }
+            if (_csv.is_open())
+            {
+                writeLine(_csv, _frame, &_times[_next * _current.size()]);
+            }
+            _current.assign(_current.size(), 0.0);
+            _next = (_next + 1) % _history;
+            _count = _count < _history ? _count + 1 : _history;
+            ++_frame;
+        }
+
+        //writes every frame to path from now on, returns false if it can not be opened
+        bool streamCsv(const std::string& path)
+        {
+            _csv.open(path.c_str());
+            if (!_csv)
+            {
+                return false;
+            }
+            writeHeader(_csv);
+            return true;
+        }
+
+        //streamCsv for the path given with --profile, once the stages are declared
+        //nothing to do for an empty path, else returns false and says so on std::cerr
+        //if the file can not be opened
+        bool startStream(const std::string& path)
+        {
+            if (path.empty() || streamCsv(path))
+            {
+                return true;
+            }
+            std::cerr << "can not write " << path << std::endl;
+            return false;
+        }
+
+        //writes the frames in the ring buffer, oldest first
+        void writeCsv(std::ostream& out) const
+        {
+            writeHeader(out);
+            for (size_t f = 0; f < _count; ++f)
+            {
+                writeLine(out, _frame - _count + f, &_times[slot(f) * _current.size()]);
+            }
+        }
+
+        //the names of the stages from the bottom of the overlay up, its legend
+        void writeLegend(std::ostream& out) const
+        {
+            out << "profiler stages, from the bottom up : ";
+            for (size_t s = 0; s < _names.size(); ++s)
+            {
+                out << (s > 0 ? ", " : "") << _names[s];
+            }
+            out << std::endl;
+        }
+
+        size_t getStageCount() const
+        {
+            return _names.size();
+        }
+
+        const std::string& getStageName(size_t stage) const
+        {
+            return _names[stage];
+        }
+
+        const sf::Color& getStageColor(size_t stage) const
+        {
+            return _colors[stage];
+        }
+
+        //number of frames in the ring buffer, up to its size
+        size_t getFrameCount() const
+        {
+            return _count;
+        }
+
+        size_t getHistory() const
+        {
+            return _history;
+        }
+
+        //ms spent in a stage of a frame of the ring buffer, 0 is the oldest
+        float getTime(size_t frame, size_t stage) const
+        {
+            return _times[slot(frame) * _current.size() + stage];
+        }
+
+    private:
+
+        size_t slot(size_t frame) const
+        {
+            return (_next + _history - _count + frame) % _history;
+        }
+
+        void writeHeader(std::ostream& out) const
+        {
+            out << "frame";
+            for (size_t s = 0; s < _names.size(); ++s)
+            {
+                out << "," << _names[s];
+            }
+            out << "\n";
+        }
+
+        void writeLine(std::ostream& out, size_t frame, const float* times) const
+        {
+            out << frame;
+            for (size_t s = 0; s < _names.size(); ++s)
+            {
+                out << "," << times[s];
+            }
+            out << "\n";
+        }
+
+        size_t _history;
+        std::vector<std::string> _names;
+        std::vector<sf::Color> _colors;
+        //ms of the frame being recorded, per stage
+        std::vector<double> _current;
+        //ms of the last frames, per frame then per stage, _next is the oldest once full
+        std::vector<float> _times;
+        size_t _next;
+        size_t _count;
+        bool _enabled;
+        //number of frames recorded since the start
+        size_t _frame;
+        std::ofstream _csv;
+};
+
+//adds the time until the end of its scope, or until stop(), to a stage
+class ScopedStage
+{
+    public:
+
+        ScopedStage(Profiler& profiler, size_t stage) : _profiler(profiler), _stage(stage), _running(profiler.isEnabled())
+        {
+            if (_running)
+            {
+                _start = Profiler::Clock::now();
+            }
+        }
+
+        ~ScopedStage()
+        {
+            stop();
+        }
+
+        //ends the stage before the end of the scope
+        void stop()
+        {
+            if (_running)
+            {
+                _profiler.add(_stage, std::chrono::duration<double, std::milli>(Profiler::Clock::now() - _start).count());
+                _running = false;
+            }
+        }
+
+    private:
+
+        ScopedStage(const ScopedStage&);
+        ScopedStage& operator=(const ScopedStage&);
+
+        Profiler& _profiler;
+        size_t _stage;
+        bool _running;
+        Profiler::Clock::time_point _start;
+};
+
+//the frames of a profiler as stacked bars, one color per stage from the bottom up
+//and the newest frame on the right. The white lines are at 1/60 and 1/30 s, and the
+//squares under the graph are the colors of the stages in order
+//nothing is drawn while the profiler is not shown
+class ProfilerOverlay : public sf::Drawable
+{
+    public:
+
+        ProfilerOverlay(const Profiler& profiler, const sf::FloatRect& area, float maxMs = 40.0f) :
+            _profiler(profiler), _area(area), _maxMs(maxMs), _vertices(sf::Triangles)
+        {
+        }
+
+    protected:
+
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const
+        {
+            if (!_profiler.isShown())
+            {
+                return;
+            }
+            _vertices.clear();
+            const float legend = 8.0f;
+            addRect(_area.left, _area.top, _area.width, _area.height + legend + 4.0f, sf::Color(0, 0, 0, 160));
+
+            const float barWidth = _area.width / _profiler.getHistory();
+            const float scale = _area.height / _maxMs;
+            const float bottom = _area.top + _area.height;
+            const size_t count = _profiler.getFrameCount();
+            for (size_t f = 0; f < count; ++f)
+            {
+                const float x = _area.left + _area.width - (count - f) * barWidth;
+                float y = bottom;
+                for (size_t s = 0; s < _profiler.getStageCount() && y > _area.top; ++s)
+                {
+                    const float height = std::min(_profiler.getTime(f, s) * scale, y - _area.top);
+                    addRect(x, y - height, barWidth, height, _profiler.getStageColor(s));
+                    y -= height;
+                }
+            }
+
+            const float targets[] = { 1000.0f / 60.0f, 1000.0f / 30.0f };
+            for (size_t i = 0; i < 2; ++i)
+            {
+                if (targets[i] < _maxMs)
+                {
+                    addRect(_area.left, bottom - targets[i] * scale, _area.width, 1.0f, sf::Color(255, 255, 255, 160));
+                }
+            }
+
+            for (size_t s = 0; s < _profiler.getStageCount(); ++s)
+            {
+                addRect(_area.left + 2.0f + s * (legend + 4.0f), bottom + 2.0f, legend, legend, _profiler.getStageColor(s));
+            }
+
+            target.draw(_vertices, states);
+        }
+
+    private:
+
+        void addRect(float x, float y, float width, float height, const sf::Color& color) const
+        {
+            const sf::Vertex a(sf::Vector2f(x, y), color);
+            const sf::Vertex b(sf::Vector2f(x + width, y), color);
+            const sf::Vertex c(sf::Vector2f(x + width, y + height), color);
+            const sf::Vertex d(sf::Vector2f(x, y + height), color);
+            _vertices.append(a);
+            _vertices.append(b);
+            _vertices.append(c);
+            _vertices.append(a);
+            _vertices.append(c);
+            _vertices.append(d);
+        }
+
+        const Profiler& _profiler;
+        sf::FloatRect _area;
+        float _maxMs;
+        //rebuilt every draw, it keeps its capacity
+        mutable sf::VertexArray _vertices;
+};
+
+//the argument every demo takes, --profile file.csv at argv[i] goes in path and i
+//moves to the file, returns false for any other argument
+inline bool parseProfileArgument(int argc, char** argv, int& i, std::string& path)
+{
+    if (std::strcmp(argv[i], "--profile") != 0 || i + 1 >= argc)
+    {
+        return false;
+    }
+    path = argv[++i];
+    return true;
+}
+
+} // !namespace sandbox
+
+#endif // SANDBOX_PROFILER_HPP
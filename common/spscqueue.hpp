@@ -0,0 +1,60 @@
+#ifndef SANDBOX_SPSCQUEUE_HPP
+#define SANDBOX_SPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace sandbox
+{
+
+//fixed size ring buffer between one producer thread and one consumer thread,
+//without locks. Capacity must be a power of two, and Capacity - 1 items fit in it
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "the capacity must be a power of two");
+
+    public:
+
+        SpscQueue() : _head(0), _tail(0)
+        {
+        }
+
+        //producer side, returns false and drops item if the queue is full
+        bool push(const T& item)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            const size_t next = (tail + 1) & (Capacity - 1);
+            if (next == _head.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            _items[tail] = item;
+            _tail.store(next, std::memory_order_release);
+            return true;
+        }
+
+        //consumer side, returns false if the queue is empty
+        bool pop(T& item)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            item = _items[head];
+            _head.store((head + 1) & (Capacity - 1), std::memory_order_release);
+            return true;
+        }
+
+    private:
+
+        T _items[Capacity];
+        //the two ends are written by different threads, they are kept on their own cache lines
+        alignas(64) std::atomic<size_t> _head;
+        alignas(64) std::atomic<size_t> _tail;
+};
+
+} // !namespace sandbox
+
+#endif // SANDBOX_SPSCQUEUE_HPP
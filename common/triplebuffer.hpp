@@ -0,0 +1,73 @@
+#ifndef SANDBOX_TRIPLEBUFFER_HPP
+#define SANDBOX_TRIPLEBUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace sandbox
+{
+
+//hands the latest value written by one thread to one other thread, without locks
+//the writer fills back() and publishes it, the reader picks the latest published
+//value with update() and reads it through front(). The third buffer sits between
+//them, so neither side ever waits for the other or sees a half written value
+//the values are reused, a writer that keeps the same sizes does not allocate
+template <typename T>
+class TripleBuffer
+{
+    public:
+
+        TripleBuffer() : _back(0), _middle(1), _front(2)
+        {
+        }
+
+        //writer side, the buffer to fill
+        T& back()
+        {
+            return _buffers[_back];
+        }
+
+        //writer side, makes back() the latest value and gives a new buffer to fill
+        void publish()
+        {
+            _back = _middle.exchange(_back | Fresh, std::memory_order_acq_rel) & Index;
+        }
+
+        //reader side, takes the latest published value if there is a new one
+        //returns true if front() changed
+        bool update()
+        {
+            if (!(_middle.load(std::memory_order_relaxed) & Fresh))
+            {
+                return false;
+            }
+            _front = _middle.exchange(_front, std::memory_order_acq_rel) & Index;
+            return true;
+        }
+
+        //reader side, the value taken by the last update()
+        const T& front() const
+        {
+            return _buffers[_front];
+        }
+
+    private:
+
+        enum
+        {
+            Index = 3,
+            //set in _middle when it holds a value the reader has not taken yet
+            Fresh = 4
+        };
+
+        T _buffers[3];
+        //only touched by the writer
+        uint8_t _back;
+        std::atomic<uint8_t> _middle;
+        //only touched by the reader
+        uint8_t _front;
+};
+
+} // !namespace sandbox
+
+#endif // SANDBOX_TRIPLEBUFFER_HPP
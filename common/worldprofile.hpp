@@ -0,0 +1,61 @@
+#ifndef SANDBOX_WORLDPROFILE_HPP
+#define SANDBOX_WORLDPROFILE_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#include <Box2D/Box2D.h>
+
+#include "profiler.hpp"
+
+namespace sandbox
+{
+
+//adds the times of a step to sum, for the frames that step more than once
+inline void accumulate(b2Profile& sum, const b2Profile& step)
+{
+    sum.step += step.step;
+    sum.collide += step.collide;
+    sum.solve += step.solve;
+    sum.solveInit += step.solveInit;
+    sum.solveVelocity += step.solveVelocity;
+    sum.solvePosition += step.solvePosition;
+    sum.broadphase += step.broadphase;
+    sum.solveTOI += step.solveTOI;
+}
+
+//the stages of b2World::GetProfile() in a Profiler
+//box2D times the broadphase inside the solve, the solve stage is what is left so
+//the stages can be stacked
+class WorldStages
+{
+    public:
+
+        explicit WorldStages(Profiler& profiler) : _profiler(profiler)
+        {
+            _collide = profiler.addStage("collide", sf::Color(230, 120, 40));
+            _solve = profiler.addStage("solve", sf::Color(220, 50, 50));
+            _solveTOI = profiler.addStage("solveTOI", sf::Color(170, 60, 170));
+            _broadphase = profiler.addStage("broadphase", sf::Color(230, 200, 40));
+        }
+
+        void add(const b2Profile& profile)
+        {
+            _profiler.add(_collide, profile.collide);
+            _profiler.add(_solve, std::max(0.0f, profile.solve - profile.broadphase));
+            _profiler.add(_solveTOI, profile.solveTOI);
+            _profiler.add(_broadphase, profile.broadphase);
+        }
+
+    private:
+
+        Profiler& _profiler;
+        size_t _collide;
+        size_t _solve;
+        size_t _solveTOI;
+        size_t _broadphase;
+};
+
+} // !namespace sandbox
+
+#endif // SANDBOX_WORLDPROFILE_HPP
@@ -0,0 +1,932 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "inclusion.hpp"
+#include "convexpolygon.hpp"
+#include "batch.hpp"
+#include "polygonindex.hpp"
+#include "polygon.hpp"
+#include "transformedpolygon.hpp"
+#include "walkingquery.hpp"
+#include "coveragemask.hpp"
+#include "orientation.hpp"
+#include "hull.hpp"
+#include "intersection.hpp"
+
+//headless benchmark of the containment queries on seeded random points
+//usage : polygonInclusion-bench [--seed n] [--out file.json] [--min-time seconds]
+//every query is checked against a simpler one, the exit code is 2 if any result differs
+
+namespace
+{
+
+struct Result
+{
+    std::string query;
+    size_t vertices;
+    size_t points;
+    size_t inside;
+    size_t iterations;
+    double nsPerOp;
+};
+
+struct IndexResult
+{
+    size_t polygons;
+    size_t queries;
+    size_t found;
+    size_t cells;
+    size_t memoryBytes;
+    double buildMs;
+    double nsPerOp;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+    //checked queries found in another zone than the scan of all the zones finds
+    size_t mismatches;
+};
+
+struct CoverageResult
+{
+    size_t vertices;
+    float cellSize;
+    size_t cells;
+    size_t boundaryCells;
+    size_t memoryBytes;
+    double buildMs;
+};
+
+struct HullResult
+{
+    size_t points;
+    size_t threads;
+    size_t hullPoints;
+    size_t iterations;
+    double ms;
+};
+
+//regular polygon of radius 100 around (0,0), slightly rotated so no edge is axis aligned
+sf::ConvexShape makePolygon(size_t vertices)
+{
+    const double PI = 3.14159265359;
+    sf::ConvexShape shape(vertices);
+    for (size_t i = 0; i < vertices; ++i)
+    {
+        double angle = 0.1 + 2.0 * PI * i / vertices;
+        shape.setPoint(i, sf::Vector2f(static_cast<float>(100.0 * std::cos(angle)), static_cast<float>(100.0 * std::sin(angle))));
+    }
+    return shape;
+}
+
+//closed curve whose radius waves between 80 and 120 seven times, so it is concave
+//while a horizontal line only crosses a few of its edges, like most outlines
+std::vector<sf::Vector2f> makeWavy(size_t vertices)
+{
+    const double PI = 3.14159265359;
+    std::vector<sf::Vector2f> points(vertices);
+    for (size_t i = 0; i < vertices; ++i)
+    {
+        double angle = 0.1 + 2.0 * PI * i / vertices;
+        double radius = 100.0 + 20.0 * std::sin(7.0 * angle);
+        points[i] = sf::Vector2f(static_cast<float>(radius * std::cos(angle)), static_cast<float>(radius * std::sin(angle)));
+    }
+    return points;
+}
+
+//winding number over every edge, what the slabs avoid
+int windingScan(const std::vector<sf::Vector2f>& points, const sf::Vector2f& p)
+{
+    int w = 0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        const sf::Vector2f& a = points[i];
+        const sf::Vector2f& b = points[(i + 1) % points.size()];
+        float side = inclusion::cross(b - a, p - a);
+        if (a.y <= p.y && b.y > p.y && side > 0.0f)
+        {
+            ++w;
+        }
+        else if (b.y <= p.y && a.y > p.y && side < 0.0f)
+        {
+            --w;
+        }
+    }
+    return w;
+}
+
+//points in a square 20% larger than the polygon, so a bit more than half of them are inside
+std::vector<sf::Vector2f> makePoints(size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(-120.0f, 120.0f);
+    std::vector<sf::Vector2f> points(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        points[i] = sf::Vector2f(coord(rng), coord(rng));
+    }
+    return points;
+}
+
+//probe moving by small random steps, bouncing on the borders of the point area
+std::vector<sf::Vector2f> makePath(size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+    std::vector<sf::Vector2f> points(count);
+    sf::Vector2f p(0.0f, 0.0f), v(0.3f, 0.2f);
+    for (size_t i = 0; i < count; ++i)
+    {
+        v.x = std::max(-1.0f, std::min(1.0f, v.x + 0.1f * step(rng)));
+        v.y = std::max(-1.0f, std::min(1.0f, v.y + 0.1f * step(rng)));
+        p += v;
+        if (p.x < -120.0f || p.x > 120.0f)
+        {
+            v.x = -v.x;
+        }
+        if (p.y < -120.0f || p.y > 120.0f)
+        {
+            v.y = -v.y;
+        }
+        points[i] = p;
+    }
+    return points;
+}
+
+//zones on a jittered square grid of cells of size 1, each one a random convex polygon
+//inside a circle that can go a bit over the neighbour cells
+std::vector<inclusion::ConvexPolygon> makeZones(size_t count, unsigned seed)
+{
+    const double PI = 3.14159265359;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    std::vector<inclusion::ConvexPolygon> zones(count);
+    std::vector<float> angles;
+    std::vector<sf::Vector2f> points;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sf::Vector2f center(i % side + 0.3f + 0.4f * unit(rng), i / side + 0.3f + 0.4f * unit(rng));
+        float radius = 0.3f + 0.4f * unit(rng);
+
+        //sorted random angles on a circle give a convex polygon
+        angles.resize(3 + static_cast<size_t>(10 * unit(rng)));
+        for (size_t a = 0; a < angles.size(); ++a)
+        {
+            angles[a] = static_cast<float>(2.0 * PI * unit(rng));
+        }
+        std::sort(angles.begin(), angles.end());
+        points.resize(angles.size());
+        for (size_t a = 0; a < angles.size(); ++a)
+        {
+            points[a] = center + radius * sf::Vector2f(std::cos(angles[a]), std::sin(angles[a]));
+        }
+        zones[i].setPoints(points);
+    }
+    return zones;
+}
+
+//area of a polygon given counter clockwise, in double precision
+template <typename T>
+double polygonArea(const std::vector<sf::Vector2<T> >& points)
+{
+    double area = 0.0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        const sf::Vector2<T>& p = points[i];
+        const sf::Vector2<T>& q = points[(i + 1) % points.size()];
+        area += static_cast<double>(p.x) * q.y - static_cast<double>(p.y) * q.x;
+    }
+    return area / 2.0;
+}
+
+//area of the intersection of a and b by Sutherland-Hodgman clipping of a by every
+//edge of b in double precision, what inclusion::intersection is checked against
+double clippedArea(const inclusion::ConvexPolygon& a, const inclusion::ConvexPolygon& b)
+{
+    typedef sf::Vector2<double> Point;
+    const std::vector<sf::Vector2f>& clip = b.getPoints();
+    if (a.getPoints().size() < 3 || clip.size() < 3)
+    {
+        return 0.0;
+    }
+
+    std::vector<Point> subject, clipped;
+    for (size_t i = 0; i < a.getPoints().size(); ++i)
+    {
+        subject.push_back(Point(a.getPoints()[i].x, a.getPoints()[i].y));
+    }
+    for (size_t e = 0; e < clip.size() && !subject.empty(); ++e)
+    {
+        const Point p(clip[e].x, clip[e].y);
+        const Point q(clip[(e + 1) % clip.size()].x, clip[(e + 1) % clip.size()].y);
+        clipped.clear();
+        for (size_t i = 0; i < subject.size(); ++i)
+        {
+            const Point& c = subject[i];
+            const Point& n = subject[(i + 1) % subject.size()];
+            const double sc = (q.x - p.x) * (c.y - p.y) - (q.y - p.y) * (c.x - p.x);
+            const double sn = (q.x - p.x) * (n.y - p.y) - (q.y - p.y) * (n.x - p.x);
+            if (sc >= 0.0)
+            {
+                clipped.push_back(c);
+            }
+            if ((sc >= 0.0) != (sn >= 0.0))
+            {
+                clipped.push_back(c + (n - c) * (sc / (sc - sn)));
+            }
+        }
+        subject.swap(clipped);
+    }
+    return polygonArea(subject);
+}
+
+//intersection and intersectionArea against each other and against clippedArea, the
+//area of out is checked too. The vertices are rounded to floats, so the areas agree
+//up to a tolerance relative to the size of the polygons
+bool checkIntersection(const inclusion::ConvexPolygon& a, const inclusion::ConvexPolygon& b, std::vector<sf::Vector2f>& out)
+{
+    const float area = inclusion::intersection(a, b, out);
+    if (area != inclusion::intersectionArea(a, b))
+    {
+        return false;
+    }
+    const sf::FloatRect& ba = a.getBounds();
+    const sf::FloatRect& bb = b.getBounds();
+    const double size = std::max(std::max(ba.width, ba.height), std::max(bb.width, bb.height));
+    const double tolerance = 1e-5 * size * size;
+    return std::abs(area - clippedArea(a, b)) <= tolerance && std::abs(area - polygonArea(out)) <= tolerance;
+}
+
+//random convex polygons that overlap, contain or miss each other, and exact
+//degenerate pairs : squares sharing an edge, a corner or part of an edge, identical
+//polygons and polygons inside another one with a vertex in common
+//returns the number of pairs failing checkIntersection
+size_t checkIntersections(unsigned seed)
+{
+    std::vector<inclusion::ConvexPolygon> zones = makeZones(400, seed);
+    std::vector<sf::Vector2f> out;
+    size_t failed = 0;
+    for (size_t i = 0; i < zones.size(); ++i)
+    {
+        for (size_t j = 0; j < zones.size(); ++j)
+        {
+            if (zones[i].getBounds().intersects(zones[j].getBounds()))
+            {
+                failed += !checkIntersection(zones[i], zones[j], out);
+            }
+        }
+
+        //the zone shrunk around its first point
+        std::vector<sf::Vector2f> inside = zones[i].getPoints();
+        for (size_t p = 1; p < inside.size(); ++p)
+        {
+            inside[p] = inside[0] + 0.5f * (inside[p] - inside[0]);
+        }
+        const inclusion::ConvexPolygon shrunk(inside);
+        failed += !checkIntersection(zones[i], shrunk, out);
+        failed += !checkIntersection(shrunk, zones[i], out);
+    }
+
+    //squares of side 2 moved by every step of 1 around another one
+    std::vector<sf::Vector2f> square(4);
+    square[0] = sf::Vector2f(0.0f, 0.0f);
+    square[1] = sf::Vector2f(2.0f, 0.0f);
+    square[2] = sf::Vector2f(2.0f, 2.0f);
+    square[3] = sf::Vector2f(0.0f, 2.0f);
+    const inclusion::ConvexPolygon fixed(square);
+    for (int dx = -3; dx <= 3; ++dx)
+    {
+        for (int dy = -3; dy <= 3; ++dy)
+        {
+            std::vector<sf::Vector2f> moved = square;
+            for (size_t p = 0; p < moved.size(); ++p)
+            {
+                moved[p] += sf::Vector2f(static_cast<float>(dx), static_cast<float>(dy));
+            }
+            const inclusion::ConvexPolygon other(moved);
+            failed += !checkIntersection(fixed, other, out);
+            failed += !checkIntersection(other, fixed, out);
+        }
+    }
+    return failed;
+}
+
+//time of the value at ratio p of the sorted times
+double percentile(const std::vector<double>& sorted, double p)
+{
+    size_t i = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+IndexResult benchIndex(size_t count, size_t queries, unsigned seed)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    std::vector<inclusion::ConvexPolygon> zones = makeZones(count, seed);
+
+    IndexResult r;
+    r.polygons = count;
+    r.queries = queries;
+
+    inclusion::PolygonIndex index;
+    Clock::time_point start = Clock::now();
+    index.build(zones);
+    r.buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    r.cells = index.getColumns() * index.getRows();
+    r.memoryBytes = index.memoryUsage();
+
+    const float side = std::ceil(std::sqrt(static_cast<float>(count)));
+    std::mt19937 rng(seed + 1);
+    std::uniform_real_distribution<float> coord(0.0f, side);
+    std::vector<sf::Vector2f> points(queries);
+    for (size_t i = 0; i < queries; ++i)
+    {
+        points[i] = sf::Vector2f(coord(rng), coord(rng));
+    }
+
+    //the first queries are checked against a scan of all the zones
+    r.mismatches = 0;
+    for (size_t i = 0; i < std::min<size_t>(queries, 1000); ++i)
+    {
+        int expected = -1;
+        for (size_t z = 0; z < zones.size() && expected == -1; ++z)
+        {
+            if (zones[z].contains(points[i]))
+            {
+                expected = static_cast<int>(z);
+            }
+        }
+        r.mismatches += index.find(points[i]) != expected;
+    }
+    if (r.mismatches != 0)
+    {
+        std::cerr << count << " zones : " << r.mismatches << " points found in the wrong zone" << std::endl;
+    }
+
+    //every query is timed on its own for the percentiles
+    std::vector<double> times(queries);
+    r.found = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < queries; ++i)
+    {
+        Clock::time_point t0 = Clock::now();
+        r.found += index.find(points[i]) != -1;
+        times[i] = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    }
+    r.nsPerOp = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queries;
+
+    std::sort(times.begin(), times.end());
+    r.p50 = percentile(times, 0.5);
+    r.p90 = percentile(times, 0.9);
+    r.p99 = percentile(times, 0.99);
+    r.max = times.back();
+    return r;
+}
+
+//runs f until minTime seconds are spent, and returns the time of one call in ns
+template <typename F>
+double measure(F f, double minTime, size_t& iterations)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    f();
+
+    iterations = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0.0;
+    do
+    {
+        f();
+        ++iterations;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < minTime);
+
+    return elapsed * 1e9 / iterations;
+}
+
+size_t countBits(const std::vector<uint32_t>& mask)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < mask.size(); ++i)
+    {
+        for (uint32_t m = mask[i]; m != 0; m &= m - 1)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void writeJson(std::ostream& out, unsigned seed, const std::vector<Result>& results, const std::vector<IndexResult>& indexResults,
+    const std::vector<CoverageResult>& coverageResults, const std::vector<HullResult>& hullResults)
+{
+    out << "{\n";
+    out << "  \"seed\": " << seed << ",\n";
+    out << "  \"instruction_set\": \"" << inclusion::batchInstructionSet() << "\",\n";
+#ifdef INCLUSION_ORIENTATION_STATS
+    //every query of the run is counted, the warm up and mismatch checks included
+    const inclusion::OrientationStats stats = inclusion::getOrientationStats();
+    out << "  \"orientation\": {"
+        << "\"calls\": " << stats.calls << ", "
+        << "\"exact_calls\": " << stats.exactCalls << ", "
+        << "\"exact_rate\": " << stats.exactRate()
+        << "},\n";
+#endif
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& r = results[i];
+        out << "    {"
+            << "\"query\": \"" << r.query << "\", "
+            << "\"vertices\": " << r.vertices << ", "
+            << "\"points\": " << r.points << ", "
+            << "\"inside\": " << r.inside << ", "
+            << "\"iterations\": " << r.iterations << ", "
+            << "\"ns_per_op\": " << r.nsPerOp << ", "
+            << "\"ops_per_sec\": " << (r.nsPerOp > 0.0 ? 1e9 / r.nsPerOp : 0.0)
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"index\": [\n";
+    for (size_t i = 0; i < indexResults.size(); ++i)
+    {
+        const IndexResult& r = indexResults[i];
+        out << "    {"
+            << "\"polygons\": " << r.polygons << ", "
+            << "\"queries\": " << r.queries << ", "
+            << "\"found\": " << r.found << ", "
+            << "\"cells\": " << r.cells << ", "
+            << "\"memory_bytes\": " << r.memoryBytes << ", "
+            << "\"build_ms\": " << r.buildMs << ", "
+            << "\"ns_per_op\": " << r.nsPerOp << ", "
+            << "\"p50_ns\": " << r.p50 << ", "
+            << "\"p90_ns\": " << r.p90 << ", "
+            << "\"p99_ns\": " << r.p99 << ", "
+            << "\"max_ns\": " << r.max
+            << "}" << (i + 1 < indexResults.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"coverage\": [\n";
+    for (size_t i = 0; i < coverageResults.size(); ++i)
+    {
+        const CoverageResult& r = coverageResults[i];
+        out << "    {"
+            << "\"vertices\": " << r.vertices << ", "
+            << "\"cell_size\": " << r.cellSize << ", "
+            << "\"cells\": " << r.cells << ", "
+            << "\"boundary_cells\": " << r.boundaryCells << ", "
+            << "\"memory_bytes\": " << r.memoryBytes << ", "
+            << "\"build_ms\": " << r.buildMs
+            << "}" << (i + 1 < coverageResults.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"hull\": [\n";
+    for (size_t i = 0; i < hullResults.size(); ++i)
+    {
+        const HullResult& r = hullResults[i];
+        out << "    {"
+            << "\"points\": " << r.points << ", "
+            << "\"threads\": " << r.threads << ", "
+            << "\"hull_points\": " << r.hullPoints << ", "
+            << "\"iterations\": " << r.iterations << ", "
+            << "\"ms\": " << r.ms
+            << "}" << (i + 1 < hullResults.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+} // !namespace
+
+int main(int argc, char** argv)
+{
+    unsigned seed = 1;
+    double minTime = 0.2;
+    std::string outFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            outFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+        {
+            minTime = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage : " << argv[0] << " [--seed n] [--out file.json] [--min-time seconds]" << std::endl;
+            return 1;
+        }
+    }
+
+    //every check failing is counted, the run then exits with 2
+    size_t failures = checkIntersections(seed);
+    if (failures != 0)
+    {
+        std::cerr << failures << " intersections differ from the clipping" << std::endl;
+    }
+
+    const size_t vertexCounts[] = { 6, 16, 100, 1000, 10000, 100000 };
+
+    std::vector<Result> results;
+    std::vector<CoverageResult> coverageResults;
+    for (size_t v = 0; v < sizeof(vertexCounts) / sizeof(vertexCounts[0]); ++v)
+    {
+        const size_t vertices = vertexCounts[v];
+        sf::ConvexShape shape = makePolygon(vertices);
+        inclusion::ConvexPolygon polygon(shape);
+
+        //fewer points for the linear scan on big polygons, to keep the run short
+        const size_t pointCount = std::max<size_t>(100, std::min<size_t>(100000, 10000000 / vertices));
+        std::vector<sf::Vector2f> points = makePoints(pointCount, seed);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            mismatches += inclusion::contains(shape, points[i]) != polygon.contains(points[i]);
+        }
+        failures += mismatches;
+        if (mismatches != 0)
+        {
+            std::cerr << vertices << " vertices : " << mismatches << " points classified differently" << std::endl;
+        }
+
+        Result r;
+        r.vertices = vertices;
+        r.points = points.size();
+
+        volatile size_t sink = 0;
+        r.query = "linear";
+        r.nsPerOp = measure([&]
+        {
+            size_t inside = 0;
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                inside += inclusion::contains(shape, points[i]);
+            }
+            sink = inside;
+        }, minTime, r.iterations) / points.size();
+        r.inside = sink;
+        results.push_back(r);
+
+        r.query = "prepared";
+        r.nsPerOp = measure([&]
+        {
+            size_t inside = 0;
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                inside += polygon.contains(points[i]);
+            }
+            sink = inside;
+        }, minTime, r.iterations) / points.size();
+        r.inside = sink;
+        results.push_back(r);
+
+        //the batch queries read the points as a structure of arrays
+        std::vector<float> xs(points.size()), ys(points.size());
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            xs[i] = points[i].x;
+            ys[i] = points[i].y;
+        }
+        std::vector<uint32_t> mask, scalarMask;
+        inclusion::containsBatch(polygon, xs.data(), ys.data(), xs.size(), mask);
+        inclusion::containsBatchScalar(polygon, xs.data(), ys.data(), xs.size(), scalarMask);
+        if (mask != scalarMask)
+        {
+            ++failures;
+            std::cerr << vertices << " vertices : the batch and scalar batch masks differ" << std::endl;
+        }
+        mismatches = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            mismatches += (((mask[i / 32] >> (i % 32)) & 1u) != 0) != polygon.contains(points[i]);
+        }
+        failures += mismatches;
+        if (mismatches != 0)
+        {
+            std::cerr << vertices << " vertices batch : " << mismatches << " points classified differently" << std::endl;
+        }
+
+        r.query = "batch_scalar";
+        r.nsPerOp = measure([&]
+        {
+            inclusion::containsBatchScalar(polygon, xs.data(), ys.data(), xs.size(), scalarMask);
+        }, minTime, r.iterations) / points.size();
+        r.inside = countBits(scalarMask);
+        results.push_back(r);
+
+        r.query = "batch";
+        r.nsPerOp = measure([&]
+        {
+            inclusion::containsBatch(polygon, xs.data(), ys.data(), xs.size(), mask);
+        }, minTime, r.iterations) / points.size();
+        r.inside = countBits(mask);
+        results.push_back(r);
+
+        //same polygon rotated and scaled, tested in its local space
+        sf::ConvexShape moved = shape;
+        moved.setRotation(30.0f);
+        moved.setScale(1.1f, 0.9f);
+        moved.setPosition(5.0f, -5.0f);
+        inclusion::TransformedPolygon transformed(moved);
+        inclusion::ConvexPolygon baked(moved);
+        mismatches = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            mismatches += baked.contains(points[i]) != transformed.contains(points[i]);
+        }
+        failures += mismatches;
+        if (mismatches != 0)
+        {
+            std::cerr << vertices << " vertices transformed : " << mismatches << " points classified differently" << std::endl;
+        }
+
+        //what the inverse transform avoids, moving every vertex for every query
+        r.query = "transformed_vertices";
+        r.nsPerOp = measure([&]
+        {
+            const sf::Transform& t = moved.getTransform();
+            std::vector<sf::Vector2f> world(moved.getPointCount());
+            size_t inside = 0;
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                for (size_t v = 0; v < world.size(); ++v)
+                {
+                    world[v] = t.transformPoint(moved.getPoint(v));
+                }
+                inside += inclusion::ConvexPolygon(world).contains(points[i]);
+            }
+            sink = inside;
+        }, minTime, r.iterations) / points.size();
+        r.inside = sink;
+        results.push_back(r);
+
+        r.query = "transformed";
+        r.nsPerOp = measure([&]
+        {
+            size_t inside = 0;
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                inside += transformed.contains(points[i]);
+            }
+            sink = inside;
+        }, minTime, r.iterations) / points.size();
+        r.inside = sink;
+        results.push_back(r);
+
+        r.query = "transformed_batch";
+        r.nsPerOp = measure([&]
+        {
+            inclusion::containsBatch(transformed, xs.data(), ys.data(), xs.size(), mask);
+        }, minTime, r.iterations) / points.size();
+        r.inside = countBits(mask);
+        results.push_back(r);
+
+        //the same polygon probed by a moving point
+        std::vector<sf::Vector2f> path = makePath(points.size(), seed);
+        inclusion::WalkingQuery walking(polygon);
+        mismatches = 0;
+        for (size_t i = 0; i < path.size(); ++i)
+        {
+            mismatches += polygon.contains(path[i]) != walking.contains(path[i]);
+        }
+        failures += mismatches;
+        if (mismatches != 0)
+        {
+            std::cerr << vertices << " vertices walking : " << mismatches << " points classified differently" << std::endl;
+        }
+
+        r.query = "path_prepared";
+        r.nsPerOp = measure([&]
+        {
+            size_t inside = 0;
+            for (size_t i = 0; i < path.size(); ++i)
+            {
+                inside += polygon.contains(path[i]);
+            }
+            sink = inside;
+        }, minTime, r.iterations) / path.size();
+        r.inside = sink;
+        results.push_back(r);
+
+        r.query = "path_walking";
+        r.nsPerOp = measure([&]
+        {
+            size_t inside = 0;
+            for (size_t i = 0; i < path.size(); ++i)
+            {
+                inside += walking.contains(path[i]);
+            }
+            sink = inside;
+        }, minTime, r.iterations) / path.size();
+        r.inside = sink;
+        results.push_back(r);
+
+        //overlap of the polygon and its moved copy, one pair per operation, against the
+        //sampling it replaces
+        //with 100000 vertices the points rounded to floats are no longer convex, and
+        //intersection needs convex polygons, only its timings are kept then
+        std::vector<sf::Vector2f> overlap;
+        if (inclusion::Polygon(polygon.getPoints()).isConvex() && inclusion::Polygon(baked.getPoints()).isConvex()
+            && !checkIntersection(polygon, baked, overlap))
+        {
+            ++failures;
+            std::cerr << vertices << " vertices : the intersection differs from the clipping" << std::endl;
+        }
+        const float area = inclusion::intersection(polygon, baked, overlap);
+        r.points = 1;
+        r.inside = area > 0.0f;
+
+        r.query = "intersection";
+        r.nsPerOp = measure([&]
+        {
+            inclusion::intersection(polygon, baked, overlap);
+        }, minTime, r.iterations);
+        results.push_back(r);
+
+        r.query = "intersection_area";
+        r.nsPerOp = measure([&]
+        {
+            sink = static_cast<size_t>(inclusion::intersectionArea(polygon, baked));
+        }, minTime, r.iterations);
+        results.push_back(r);
+
+        //1024 samples, about 3% of error on the area
+        const size_t samples = 1024;
+        r.query = "monte_carlo_area";
+        r.nsPerOp = measure([&]
+        {
+            const sf::FloatRect& bounds = polygon.getBounds();
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            size_t hits = 0;
+            for (size_t i = 0; i < samples; ++i)
+            {
+                const sf::Vector2f p(bounds.left + bounds.width * unit(rng), bounds.top + bounds.height * unit(rng));
+                hits += polygon.contains(p) && baked.contains(p);
+            }
+            sink = static_cast<size_t>(bounds.width * bounds.height * hits / samples);
+        }, minTime, r.iterations);
+        results.push_back(r);
+        r.points = points.size();
+
+        //concave polygon with the same number of vertices
+        std::vector<sf::Vector2f> wavy = makeWavy(vertices);
+        inclusion::Polygon concave(wavy);
+        mismatches = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            mismatches += (windingScan(wavy, points[i]) != 0) != concave.contains(points[i]);
+        }
+        failures += mismatches;
+        if (mismatches != 0)
+        {
+            std::cerr << vertices << " vertices wavy : " << mismatches << " points classified differently" << std::endl;
+        }
+
+        r.query = "concave_scan";
+        r.nsPerOp = measure([&]
+        {
+            size_t inside = 0;
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                inside += windingScan(wavy, points[i]) != 0;
+            }
+            sink = inside;
+        }, minTime, r.iterations) / points.size();
+        r.inside = sink;
+        results.push_back(r);
+
+        r.query = "concave_slabs";
+        r.nsPerOp = measure([&]
+        {
+            size_t inside = 0;
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                inside += concave.contains(points[i]);
+            }
+            sink = inside;
+        }, minTime, r.iterations) / points.size();
+        r.inside = sink;
+        results.push_back(r);
+
+        //the wavy polygon rasterized on cells of one unit, about 200x200 of them
+        CoverageResult c;
+        c.vertices = vertices;
+        c.cellSize = 1.0f;
+        auto buildStart = std::chrono::steady_clock::now();
+        inclusion::CoverageMask coverage(wavy, c.cellSize);
+        c.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+        c.cells = coverage.getColumns() * coverage.getRows();
+        c.boundaryCells = coverage.getBoundaryCount();
+        c.memoryBytes = coverage.memoryUsage();
+        coverageResults.push_back(c);
+        mismatches = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            mismatches += concave.contains(points[i]) != coverage.contains(points[i]);
+        }
+        failures += mismatches;
+        if (mismatches != 0)
+        {
+            std::cerr << vertices << " vertices coverage : " << mismatches << " points classified differently" << std::endl;
+        }
+
+        r.query = "concave_coverage";
+        r.nsPerOp = measure([&]
+        {
+            size_t inside = 0;
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                inside += coverage.contains(points[i]);
+            }
+            sink = inside;
+        }, minTime, r.iterations) / points.size();
+        r.inside = sink;
+        results.push_back(r);
+    }
+
+    const size_t zoneCounts[] = { 1000, 10000, 50000 };
+    std::vector<IndexResult> indexResults;
+    for (size_t z = 0; z < sizeof(zoneCounts) / sizeof(zoneCounts[0]); ++z)
+    {
+        indexResults.push_back(benchIndex(zoneCounts[z], 100000, seed));
+        failures += indexResults.back().mismatches;
+    }
+
+    //hull of gaussian clouds, checked against the single threaded one
+    const size_t cloudSizes[] = { 1000000, 4000000 };
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<HullResult> hullResults;
+    for (size_t c = 0; c < sizeof(cloudSizes) / sizeof(cloudSizes[0]); ++c)
+    {
+        std::mt19937 rng(seed);
+        std::normal_distribution<float> coord(0.0f, 100.0f);
+        std::vector<sf::Vector2f> cloud(cloudSizes[c]);
+        for (size_t i = 0; i < cloud.size(); ++i)
+        {
+            cloud[i] = sf::Vector2f(coord(rng), coord(rng));
+        }
+
+        const std::vector<sf::Vector2f> reference = inclusion::convexHull(cloud, 1);
+        //1, 2, 4... threads, up to the number of cores
+        for (size_t threads = 1; ; threads = std::min(maxThreads, threads * 2))
+        {
+            HullResult r;
+            r.points = cloud.size();
+            r.threads = threads;
+            std::vector<sf::Vector2f> hull;
+            r.ms = measure([&]
+            {
+                hull = inclusion::convexHull(cloud, threads);
+            }, minTime, r.iterations) * 1e-6;
+            r.hullPoints = hull.size();
+            if (hull != reference)
+            {
+                ++failures;
+                std::cerr << cloud.size() << " points hull on " << threads << " threads differs from the single threaded one" << std::endl;
+            }
+            hullResults.push_back(r);
+            if (threads == maxThreads)
+            {
+                break;
+            }
+        }
+    }
+
+    if (outFile.empty())
+    {
+        writeJson(std::cout, seed, results, indexResults, coverageResults, hullResults);
+    }
+    else
+    {
+        std::ofstream out(outFile.c_str());
+        if (!out)
+        {
+            std::cerr << "can not write " << outFile << std::endl;
+            return 1;
+        }
+        writeJson(out, seed, results, indexResults, coverageResults, hullResults);
+    }
+
+    return failures == 0 ? 0 : 2;
+}
@@ -0,0 +1,368 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "orientation.hpp"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define INCLUSION_BATCH_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace inclusion
+{
+
+namespace
+{
+
+//points transformed at once on the stack by the TransformedPolygon overload, a
+//multiple of 32 so every chunk fills whole words of the mask
+const size_t TRANSFORM_CHUNK = 256;
+
+//start point and direction of every edge, read from the polygon
+struct Edges
+{
+    explicit Edges(const ConvexPolygon& polygon) :
+        points(polygon.getPoints().data()), directions(polygon.getEdges().data()), count(polygon.getEdges().size())
+    {
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    const sf::Vector2f* points;
+    const sf::Vector2f* directions;
+    size_t count;
+};
+
+//bound of the rounding error of cross(edge, point - start) computed in float, relative
+//to |left| + |right|. The direction, the two differences, the products and the
+//subtraction are each rounded once, 4 FLT_EPSILON covers them with some margin
+const float ERROR_BOUND = 4.0f * FLT_EPSILON;
+//absolute part of the bound, for products that lose their precision as subnormals
+const float ERROR_FLOOR = FLT_MIN;
+
+//1 if the point is left of edge e, -1 if it is right and 0 if it is on it
+//the sign computed in float is kept when it is larger than the bound of its error,
+//like orientation() does in double, otherwise orientation() decides
+inline int side(const Edges& edges, size_t e, float x, float y)
+{
+    float left = edges.directions[e].x * (y - edges.points[e].y);
+    float right = (x - edges.points[e].x) * edges.directions[e].y;
+    float d = left - right;
+    float bound = ERROR_BOUND * (std::abs(left) + std::abs(right)) + ERROR_FLOOR;
+    if (d > bound)
+    {
+        return 1;
+    }
+    if (d < -bound)
+    {
+        return -1;
+    }
+    return orientation(edges.points[e], edges.points[(e + 1) % edges.size()], sf::Vector2f(x, y));
+}
+
+//the points are counter clockwise, so a point is inside if it is not right of any
+//edge. The vector paths below use the same filter, and test the lanes it can not
+//decide with this function, so every path gives the result of ConvexPolygon::contains
+inline bool testPoint(const Edges& edges, float x, float y)
+{
+    if (edges.size() == 0)
+    {
+        return false;
+    }
+    for (size_t e = 0; e < edges.size(); ++e)
+    {
+        if (side(edges, e, x, y) < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//clears the bits of the lanes in unsure that testPoint finds outside, first is the
+//index of the point of bit 0
+inline uint32_t resolveLanes(const Edges& edges, const float* x, const float* y, size_t first, uint32_t inside, uint32_t unsure)
+{
+    for (; unsure != 0; unsure &= unsure - 1)
+    {
+        uint32_t lane = 0;
+        while (!((unsure >> lane) & 1u))
+        {
+            ++lane;
+        }
+        if (!testPoint(edges, x[first + lane], y[first + lane]))
+        {
+            inside &= ~(1u << lane);
+        }
+    }
+    return inside;
+}
+
+//the matrix is 4x4 and column major, only the 2D affine part is used
+inline void transformPoint(const float* m, float x, float y, float& outX, float& outY)
+{
+    float tx = m[0] * x + m[4] * y + m[12];
+    float ty = m[1] * x + m[5] * y + m[13];
+    outX = tx;
+    outY = ty;
+}
+
+void transformRangeScalar(const float* m, const float* x, const float* y, size_t begin, size_t end, float* outX, float* outY)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        transformPoint(m, x[i], y[i], outX[i], outY[i]);
+    }
+}
+
+void testRangeScalar(const Edges& edges, const float* x, const float* y, size_t begin, size_t end, uint32_t* mask)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (testPoint(edges, x[i], y[i]))
+        {
+            mask[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
+
+//sets the bits of the points inside polygon in mask, that holds (count + 31) / 32
+//words set to 0, with the instruction set of containsBatch
+void containsWords(const ConvexPolygon& polygon, const float* x, const float* y, size_t count, uint32_t* mask);
+
+} // !namespace
+
+void containsBatchScalar(const ConvexPolygon& polygon, const float* x, const float* y, size_t count, std::vector<uint32_t>& mask)
+{
+    mask.assign((count + 31) / 32, 0u);
+    testRangeScalar(Edges(polygon), x, y, 0, count, mask.data());
+}
+
+void containsBatch(const ConvexPolygon& polygon, const float* x, const float* y, size_t count, std::vector<uint32_t>& mask)
+{
+    mask.assign((count + 31) / 32, 0u);
+    containsWords(polygon, x, y, count, mask.data());
+}
+
+void transformPointsScalar(const sf::Transform& t, const float* x, const float* y, size_t count, float* outX, float* outY)
+{
+    transformRangeScalar(t.getMatrix(), x, y, 0, count, outX, outY);
+}
+
+void containsBatch(const TransformedPolygon& polygon, const float* x, const float* y, size_t count, std::vector<uint32_t>& mask)
+{
+    mask.assign((count + 31) / 32, 0u);
+    const Polygon& local = polygon.getLocalPolygon();
+    float localX[TRANSFORM_CHUNK], localY[TRANSFORM_CHUNK];
+    for (size_t begin = 0; begin < count; begin += TRANSFORM_CHUNK)
+    {
+        const size_t n = std::min(TRANSFORM_CHUNK, count - begin);
+        transformPoints(polygon.getInverseTransform(), x + begin, y + begin, n, localX, localY);
+        if (local.isConvex())
+        {
+            containsWords(local.getConvexPolygon(), localX, localY, n, &mask[begin / 32]);
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (local.contains(sf::Vector2f(localX[i], localY[i])))
+            {
+                mask[(begin + i) / 32] |= 1u << ((begin + i) % 32);
+            }
+        }
+    }
+}
+
+#if defined(__AVX__)
+
+void transformPoints(const sf::Transform& t, const float* x, const float* y, size_t count, float* outX, float* outY)
+{
+    const float* m = t.getMatrix();
+    const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]);
+    const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]);
+    const __m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 tx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, px), _mm256_mul_ps(m4, py)), m12);
+        __m256 ty = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, px), _mm256_mul_ps(m5, py)), m13);
+        _mm256_storeu_ps(outX + i, tx);
+        _mm256_storeu_ps(outY + i, ty);
+    }
+
+    transformRangeScalar(m, x, y, i, count, outX, outY);
+}
+
+namespace
+{
+
+void containsWords(const ConvexPolygon& polygon, const float* x, const float* y, size_t count, uint32_t* mask)
+{
+    Edges edges(polygon);
+    if (edges.size() == 0)
+    {
+        return;
+    }
+
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 all = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 errorBound = _mm256_set1_ps(ERROR_BOUND);
+    const __m256 errorFloor = _mm256_set1_ps(ERROR_FLOOR);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 qx = _mm256_loadu_ps(x + i);
+        __m256 qy = _mm256_loadu_ps(y + i);
+        //lanes not right of any edge so far, and the ones the filter could not decide
+        __m256 inside = all;
+        __m256 unsure = zero;
+
+        for (size_t e = 0; e < edges.size(); ++e)
+        {
+            __m256 left = _mm256_mul_ps(_mm256_set1_ps(edges.directions[e].x), _mm256_sub_ps(qy, _mm256_set1_ps(edges.points[e].y)));
+            __m256 right = _mm256_mul_ps(_mm256_sub_ps(qx, _mm256_set1_ps(edges.points[e].x)), _mm256_set1_ps(edges.directions[e].y));
+            __m256 d = _mm256_sub_ps(left, right);
+            __m256 bound = _mm256_add_ps(_mm256_mul_ps(errorBound,
+                _mm256_add_ps(_mm256_andnot_ps(signMask, left), _mm256_andnot_ps(signMask, right))), errorFloor);
+            __m256 isLeft = _mm256_cmp_ps(d, bound, _CMP_GT_OQ);
+            __m256 isRight = _mm256_cmp_ps(d, _mm256_xor_ps(bound, signMask), _CMP_LT_OQ);
+            inside = _mm256_andnot_ps(isRight, inside);
+            unsure = _mm256_or_ps(unsure, _mm256_xor_ps(_mm256_or_ps(isLeft, isRight), all));
+            if (_mm256_movemask_ps(inside) == 0)
+            {
+                break;
+            }
+        }
+
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+        uint32_t unsureBits = bits & static_cast<uint32_t>(_mm256_movemask_ps(unsure));
+        mask[i / 32] |= resolveLanes(edges, x, y, i, bits, unsureBits) << (i % 32);
+    }
+
+    testRangeScalar(edges, x, y, i, count, mask);
+}
+
+} // !namespace
+
+#elif defined(INCLUSION_BATCH_SSE2)
+
+void transformPoints(const sf::Transform& t, const float* x, const float* y, size_t count, float* outX, float* outY)
+{
+    const float* m = t.getMatrix();
+    const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]);
+    const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+    const __m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, px), _mm_mul_ps(m4, py)), m12);
+        __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, px), _mm_mul_ps(m5, py)), m13);
+        _mm_storeu_ps(outX + i, tx);
+        _mm_storeu_ps(outY + i, ty);
+    }
+
+    transformRangeScalar(m, x, y, i, count, outX, outY);
+}
+
+namespace
+{
+
+void containsWords(const ConvexPolygon& polygon, const float* x, const float* y, size_t count, uint32_t* mask)
+{
+    Edges edges(polygon);
+    if (edges.size() == 0)
+    {
+        return;
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 all = _mm_cmpeq_ps(zero, zero);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 errorBound = _mm_set1_ps(ERROR_BOUND);
+    const __m128 errorFloor = _mm_set1_ps(ERROR_FLOOR);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 qx = _mm_loadu_ps(x + i);
+        __m128 qy = _mm_loadu_ps(y + i);
+        //lanes not right of any edge so far, and the ones the filter could not decide
+        __m128 inside = all;
+        __m128 unsure = zero;
+
+        for (size_t e = 0; e < edges.size(); ++e)
+        {
+            __m128 left = _mm_mul_ps(_mm_set1_ps(edges.directions[e].x), _mm_sub_ps(qy, _mm_set1_ps(edges.points[e].y)));
+            __m128 right = _mm_mul_ps(_mm_sub_ps(qx, _mm_set1_ps(edges.points[e].x)), _mm_set1_ps(edges.directions[e].y));
+            __m128 d = _mm_sub_ps(left, right);
+            __m128 bound = _mm_add_ps(_mm_mul_ps(errorBound,
+                _mm_add_ps(_mm_andnot_ps(signMask, left), _mm_andnot_ps(signMask, right))), errorFloor);
+            __m128 isLeft = _mm_cmpgt_ps(d, bound);
+            __m128 isRight = _mm_cmplt_ps(d, _mm_xor_ps(bound, signMask));
+            inside = _mm_andnot_ps(isRight, inside);
+            unsure = _mm_or_ps(unsure, _mm_xor_ps(_mm_or_ps(isLeft, isRight), all));
+            if (_mm_movemask_ps(inside) == 0)
+            {
+                break;
+            }
+        }
+
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(inside));
+        uint32_t unsureBits = bits & static_cast<uint32_t>(_mm_movemask_ps(unsure));
+        mask[i / 32] |= resolveLanes(edges, x, y, i, bits, unsureBits) << (i % 32);
+    }
+
+    testRangeScalar(edges, x, y, i, count, mask);
+}
+
+} // !namespace
+
+#else
+
+void transformPoints(const sf::Transform& t, const float* x, const float* y, size_t count, float* outX, float* outY)
+{
+    transformPointsScalar(t, x, y, count, outX, outY);
+}
+
+namespace
+{
+
+void containsWords(const ConvexPolygon& polygon, const float* x, const float* y, size_t count, uint32_t* mask)
+{
+    testRangeScalar(Edges(polygon), x, y, 0, count, mask);
+}
+
+} // !namespace
+
+#endif
+
+const char* batchInstructionSet()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__AVX__)
+    return "AVX";
+#elif defined(INCLUSION_BATCH_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+} // !namespace inclusion
@@ -0,0 +1,43 @@
+#ifndef INCLUSION_BATCH_HPP
+#define INCLUSION_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "convexpolygon.hpp"
+#include "transformedpolygon.hpp"
+
+namespace inclusion
+{
+
+//classifies the points (x[i], y[i]) against every edge of polygon
+//bit (i % 32) of mask[i / 32] is set if point i is inside, border included
+//the side of an edge is computed in float and checked against a bound of its
+//error, the points too close to an edge for it are tested with orientation(), so
+//the mask is the one ConvexPolygon::contains gives
+void containsBatchScalar(const ConvexPolygon& polygon, const float* x, const float* y, size_t count, std::vector<uint32_t>& mask);
+
+//same as containsBatchScalar, 8 points at a time with AVX or 4 with SSE2
+//depending on what the library was compiled for. The results are identical
+//every point is tested against all the edges until a whole group is outside, so
+//for polygons with hundreds of vertices ConvexPolygon::contains is faster
+void containsBatch(const ConvexPolygon& polygon, const float* x, const float* y, size_t count, std::vector<uint32_t>& mask);
+
+//outX[i], outY[i] is (x[i], y[i]) transformed by t, the output can be the input
+void transformPointsScalar(const sf::Transform& t, const float* x, const float* y, size_t count, float* outX, float* outY);
+
+//same as transformPointsScalar with the same instruction set as containsBatch
+void transformPoints(const sf::Transform& t, const float* x, const float* y, size_t count, float* outX, float* outY);
+
+//points in world space, all of them are mapped to the local space of the polygon
+//in one pass before running containsBatch on its local points
+//concave polygons are tested one point at a time after the transform
+void containsBatch(const TransformedPolygon& polygon, const float* x, const float* y, size_t count, std::vector<uint32_t>& mask);
+
+//name of the instruction set used by containsBatch
+const char* batchInstructionSet();
+
+} // !namespace inclusion
+
+#endif // INCLUSION_BATCH_HPP
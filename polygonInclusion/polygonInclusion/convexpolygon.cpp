@@ -0,0 +1,172 @@
+#include "convexpolygon.hpp"
+#include "inclusion.hpp"
+
+#include <algorithm>
+
+namespace inclusion
+{
+
+ConvexPolygon::ConvexPolygon() : _risingStart(0), _risingCount(0), _fallingStart(0), _fallingCount(0)
+{
+}
+
+ConvexPolygon::ConvexPolygon(const sf::ConvexShape& shape) : _risingStart(0), _risingCount(0), _fallingStart(0), _fallingCount(0)
+{
+    const sf::Transform& t = shape.getTransform();
+    std::vector<sf::Vector2f> points(shape.getPointCount());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        points[i] = t.transformPoint(shape.getPoint(i));
+    }
+    setPoints(points);
+}
+
+ConvexPolygon::ConvexPolygon(const std::vector<sf::Vector2f>& points) : _risingStart(0), _risingCount(0), _fallingStart(0), _fallingCount(0)
+{
+    setPoints(points);
+}
+
+void ConvexPolygon::setPoints(const std::vector<sf::Vector2f>& points)
+{
+    //repeated points would give empty triangles in the fan
+    _points.clear();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        if (_points.empty() || points[i] != _points.back())
+        {
+            _points.push_back(points[i]);
+        }
+    }
+    while (_points.size() > 1 && _points.back() == _points.front())
+    {
+        _points.pop_back();
+    }
+
+    float area = 0.0f;
+    for (size_t i = 0; i < _points.size(); ++i)
+    {
+        area += cross(_points[i], _points[(i + 1) % _points.size()]);
+    }
+    if (area < 0.0f)
+    {
+        std::reverse(_points.begin(), _points.end());
+    }
+
+    _edges.clear();
+    for (size_t i = 0; _points.size() >= 3 && i < _points.size(); ++i)
+    {
+        _edges.push_back(_points[(i + 1) % _points.size()] - _points[i]);
+    }
+
+    _bounds = sf::FloatRect();
+    _min = _max = sf::Vector2f();
+    if (!_points.empty())
+    {
+        float left = _points[0].x, right = _points[0].x;
+        float top = _points[0].y, bottom = _points[0].y;
+        for (size_t i = 1; i < _points.size(); ++i)
+        {
+            left = std::min(left, _points[i].x);
+            right = std::max(right, _points[i].x);
+            top = std::min(top, _points[i].y);
+            bottom = std::max(bottom, _points[i].y);
+        }
+        _bounds = sf::FloatRect(left, top, right - left, bottom - top);
+        _min = sf::Vector2f(left, top);
+        _max = sf::Vector2f(right, bottom);
+    }
+
+    //the rising chain goes from the last lowest point to the first highest one, the
+    //falling chain from the last highest point to the first lowest one, so the
+    //horizontal edges at the top and bottom are in neither of them
+    _risingStart = _risingCount = 0;
+    _fallingStart = _fallingCount = 0;
+    const size_t n = _points.size();
+    if (n < 3 || _bounds.height == 0.0f)
+    {
+        return;
+    }
+
+    //top + height is rounded, the extreme y are taken from the points themselves
+    size_t lowest = 0, highest = 0;
+    for (size_t i = 1; i < n; ++i)
+    {
+        if (_points[i].y < _points[lowest].y)
+        {
+            lowest = i;
+        }
+        if (_points[i].y > _points[highest].y)
+        {
+            highest = i;
+        }
+    }
+    const float minY = _points[lowest].y;
+    const float maxY = _points[highest].y;
+
+    size_t firstLowest = lowest, lastLowest = lowest;
+    while (_points[(firstLowest + n - 1) % n].y == minY)
+    {
+        firstLowest = (firstLowest + n - 1) % n;
+    }
+    while (_points[(lastLowest + 1) % n].y == minY)
+    {
+        lastLowest = (lastLowest + 1) % n;
+    }
+    size_t firstHighest = highest, lastHighest = highest;
+    while (_points[(firstHighest + n - 1) % n].y == maxY)
+    {
+        firstHighest = (firstHighest + n - 1) % n;
+    }
+    while (_points[(lastHighest + 1) % n].y == maxY)
+    {
+        lastHighest = (lastHighest + 1) % n;
+    }
+
+    _risingStart = lastLowest;
+    _risingCount = (firstHighest + n - lastLowest) % n;
+    _fallingStart = lastHighest;
+    _fallingCount = (firstLowest + n - lastHighest) % n;
+}
+
+size_t ConvexPolygon::memoryUsage() const
+{
+    return (_points.capacity() + _edges.capacity()) * sizeof(sf::Vector2f);
+}
+
+bool ConvexPolygon::contains(const sf::Vector2f& point) const
+{
+    const size_t n = _points.size();
+    if (n < 3
+        || point.x < _min.x || point.x > _max.x
+        || point.y < _min.y || point.y > _max.y)
+    {
+        return false;
+    }
+
+    //outside of the wedge made by the first and last edges of the fan
+    const sf::Vector2f& p0 = _points[0];
+    if (orientation(p0, _points[1], point) < 0 || orientation(p0, _points[n - 1], point) > 0)
+    {
+        return false;
+    }
+
+    //last fan edge p0>p[lo] that has the point on its left
+    size_t lo = 1, hi = n - 1;
+    while (hi - lo > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (orientation(p0, _points[mid], point) >= 0)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    //the point is in the wedge of triangle p0, p[lo], p[lo+1], check the outer edge
+    return orientation(_points[lo], _points[lo + 1], point) >= 0;
+}
+
+} // !namespace inclusion
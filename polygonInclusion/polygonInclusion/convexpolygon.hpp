@@ -0,0 +1,93 @@
+#ifndef INCLUSION_CONVEXPOLYGON_HPP
+#define INCLUSION_CONVEXPOLYGON_HPP
+
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace inclusion
+{
+
+//convex polygon prepared for containment queries
+//the points are stored once in world space and counter clockwise order, and split
+//in a fan of triangles around the first one. contains() finds the triangle of the
+//point with a binary search over the fan, so it runs in O(log n)
+class ConvexPolygon
+{
+    public:
+
+        ConvexPolygon();
+
+        //takes the full transform of shape into account
+        explicit ConvexPolygon(const sf::ConvexShape& shape);
+
+        //points of a convex polygon in any winding order
+        explicit ConvexPolygon(const std::vector<sf::Vector2f>& points);
+
+        void setPoints(const std::vector<sf::Vector2f>& points);
+
+        //points on the border are inside, like the ones of inclusion::contains
+        bool contains(const sf::Vector2f& point) const;
+
+        const std::vector<sf::Vector2f>& getPoints() const
+        {
+            return _points;
+        }
+
+        //edge i goes from point i to point i+1, empty below 3 points
+        //the batch queries read them instead of building them on every call
+        const std::vector<sf::Vector2f>& getEdges() const
+        {
+            return _edges;
+        }
+
+        const sf::FloatRect& getBounds() const
+        {
+            return _bounds;
+        }
+
+        //bytes allocated by the polygon, sizeof(ConvexPolygon) not included
+        size_t memoryUsage() const;
+
+        //edges going from the lowest y to the highest one, the first one is edge
+        //getRisingStart(), that goes from point i to point i+1
+        size_t getRisingStart() const
+        {
+            return _risingStart;
+        }
+
+        size_t getRisingCount() const
+        {
+            return _risingCount;
+        }
+
+        //edges going back from the highest y to the lowest one
+        //horizontal edges at the top or bottom are in neither chain
+        size_t getFallingStart() const
+        {
+            return _fallingStart;
+        }
+
+        size_t getFallingCount() const
+        {
+            return _fallingCount;
+        }
+
+    private:
+
+        std::vector<sf::Vector2f> _points;
+        std::vector<sf::Vector2f> _edges;
+        sf::FloatRect _bounds;
+        //exact corners of the bounds, left + width and top + height are rounded
+        sf::Vector2f _min;
+        sf::Vector2f _max;
+
+        size_t _risingStart;
+        size_t _risingCount;
+        size_t _fallingStart;
+        size_t _fallingCount;
+};
+
+} // !namespace inclusion
+
+#endif // INCLUSION_CONVEXPOLYGON_HPP
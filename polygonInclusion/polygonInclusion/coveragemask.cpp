@@ -0,0 +1,171 @@
+#include "coveragemask.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace inclusion
+{
+
+namespace
+{
+
+//cells are widened by this fraction of their size when marking the border, so the
+//rounding of a query that falls on the side of a cell can not reach an inside or
+//outside cell the border actually touches
+const float margin = 1e-3f;
+
+} // !namespace
+
+CoverageMask::CoverageMask() : _cellSize(1.0f), _invCellSize(1.0f), _columns(0), _rows(0), _boundaryCount(0)
+{
+}
+
+CoverageMask::CoverageMask(const sf::ConvexShape& shape, float cellSize) : _cellSize(1.0f), _invCellSize(1.0f), _columns(0), _rows(0), _boundaryCount(0)
+{
+    const sf::Transform& t = shape.getTransform();
+    std::vector<sf::Vector2f> points(shape.getPointCount());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        points[i] = t.transformPoint(shape.getPoint(i));
+    }
+    setPoints(points, cellSize);
+}
+
+CoverageMask::CoverageMask(const std::vector<sf::Vector2f>& points, float cellSize) : _cellSize(1.0f), _invCellSize(1.0f), _columns(0), _rows(0), _boundaryCount(0)
+{
+    setPoints(points, cellSize);
+}
+
+void CoverageMask::setPoints(const std::vector<sf::Vector2f>& points, float cellSize)
+{
+    _polygon.setPoints(points);
+    _cellSize = cellSize;
+    _invCellSize = 1.0f / cellSize;
+    _cells.clear();
+    _columns = 0;
+    _rows = 0;
+    _boundaryCount = 0;
+    if (points.size() < 3)
+    {
+        return;
+    }
+
+    //one more cell than the bounds need, so the right and bottom sides are in the grid
+    const sf::FloatRect& bounds = _polygon.getBounds();
+    _origin = sf::Vector2f(bounds.left, bounds.top);
+    _columns = static_cast<size_t>(bounds.width * _invCellSize) + 1;
+    _rows = static_cast<size_t>(bounds.height * _invCellSize) + 1;
+    _cells.assign(_columns * _rows, static_cast<uint8_t>(Outside));
+
+    const std::vector<sf::Vector2f>& p = _polygon.getPoints();
+    for (size_t i = 0; i < p.size(); ++i)
+    {
+        markEdge(p[i], p[(i + 1) % p.size()]);
+    }
+
+    //the border does not cross the cells between two border cells of a row, so they
+    //all have the state of the first one, taken at its center
+    for (size_t r = 0; r < _rows; ++r)
+    {
+        uint8_t* row = &_cells[r * _columns];
+        const float y = _origin.y + (r + 0.5f) * _cellSize;
+        for (size_t c = 0; c < _columns; ++c)
+        {
+            if (row[c] == Boundary)
+            {
+                ++_boundaryCount;
+            }
+            else if (c > 0 && row[c - 1] != Boundary)
+            {
+                row[c] = row[c - 1];
+            }
+            else
+            {
+                const sf::Vector2f center(_origin.x + (c + 0.5f) * _cellSize, y);
+                row[c] = static_cast<uint8_t>(_polygon.contains(center) ? Inside : Outside);
+            }
+        }
+    }
+}
+
+void CoverageMask::markEdge(const sf::Vector2f& a, const sf::Vector2f& b)
+{
+    //grid coordinates, in cells
+    const float ax = (a.x - _origin.x) * _invCellSize;
+    const float ay = (a.y - _origin.y) * _invCellSize;
+    const float bx = (b.x - _origin.x) * _invCellSize;
+    const float by = (b.y - _origin.y) * _invCellSize;
+
+    const float y0 = std::min(ay, by);
+    const float y1 = std::max(ay, by);
+    const size_t firstRow = static_cast<size_t>(std::max(0.0f, std::floor(y0 - margin)));
+    const size_t lastRow = std::min(_rows - 1, static_cast<size_t>(std::max(0.0f, std::floor(y1 + margin))));
+    const float dxdy = (by != ay) ? (bx - ax) / (by - ay) : 0.0f;
+
+    for (size_t r = firstRow; r <= lastRow; ++r)
+    {
+        //part of the edge inside the row, the x range of a horizontal edge is the whole edge
+        float x0, x1;
+        if (by == ay)
+        {
+            x0 = std::min(ax, bx);
+            x1 = std::max(ax, bx);
+        }
+        else
+        {
+            const float top = std::max(y0, r - margin);
+            const float bottom = std::min(y1, r + 1.0f + margin);
+            const float xt = ax + (top - ay) * dxdy;
+            const float xb = ax + (bottom - ay) * dxdy;
+            x0 = std::min(xt, xb);
+            x1 = std::max(xt, xb);
+        }
+
+        const size_t first = static_cast<size_t>(std::max(0.0f, std::floor(x0 - margin)));
+        const size_t last = std::min(_columns - 1, static_cast<size_t>(std::max(0.0f, std::floor(x1 + margin))));
+        uint8_t* row = &_cells[r * _columns];
+        for (size_t c = first; c <= last; ++c)
+        {
+            row[c] = static_cast<uint8_t>(Boundary);
+        }
+    }
+}
+
+CoverageMask::Cell CoverageMask::getCell(const sf::Vector2f& point) const
+{
+    const float x = (point.x - _origin.x) * _invCellSize;
+    const float y = (point.y - _origin.y) * _invCellSize;
+    if (_columns == 0 || !(x >= 0.0f && y >= 0.0f))
+    {
+        return Outside;
+    }
+    const size_t c = static_cast<size_t>(x);
+    const size_t r = static_cast<size_t>(y);
+    if (c >= _columns || r >= _rows)
+    {
+        return Outside;
+    }
+    return static_cast<Cell>(_cells[r * _columns + c]);
+}
+
+bool CoverageMask::contains(const sf::Vector2f& point) const
+{
+    switch (getCell(point))
+    {
+        case Inside:
+            return true;
+        case Boundary:
+            return _polygon.contains(point);
+        default:
+            return false;
+    }
+}
+
+size_t CoverageMask::memoryUsage() const
+{
+    return sizeof(*this)
+        + _cells.capacity() * sizeof(uint8_t)
+        + _polygon.memoryUsage();
+}
+
+} // !namespace inclusion
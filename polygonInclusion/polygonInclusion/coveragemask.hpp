@@ -0,0 +1,98 @@
+#ifndef INCLUSION_COVERAGEMASK_HPP
+#define INCLUSION_COVERAGEMASK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "polygon.hpp"
+
+namespace inclusion
+{
+
+//polygon rasterized on a grid of square cells covering its bounds, for hit testing
+//at a fixed resolution, like picking or heatmaps
+//every cell is fully inside, fully outside, or crossed by the border. A query in
+//an inside or outside cell is answered by a lookup, only the ones in a border cell
+//test the edges of the polygon
+//smaller cells leave fewer points to the exact test, for cells^2 more memory
+class CoverageMask
+{
+    public:
+
+        enum Cell
+        {
+            Outside = 0,
+            Inside = 1,
+            Boundary = 2
+        };
+
+        CoverageMask();
+
+        //takes the full transform of shape into account
+        CoverageMask(const sf::ConvexShape& shape, float cellSize);
+
+        //points of any polygon, with the nonzero winding rule of Polygon
+        CoverageMask(const std::vector<sf::Vector2f>& points, float cellSize);
+
+        //cellSize must be positive
+        void setPoints(const std::vector<sf::Vector2f>& points, float cellSize);
+
+        //same result as Polygon::contains
+        bool contains(const sf::Vector2f& point) const;
+
+        //state of the cell of point, Outside for a point out of the grid
+        Cell getCell(const sf::Vector2f& point) const;
+
+        const Polygon& getPolygon() const
+        {
+            return _polygon;
+        }
+
+        float getCellSize() const
+        {
+            return _cellSize;
+        }
+
+        size_t getColumns() const
+        {
+            return _columns;
+        }
+
+        size_t getRows() const
+        {
+            return _rows;
+        }
+
+        size_t getBoundaryCount() const
+        {
+            return _boundaryCount;
+        }
+
+        //bytes allocated by the mask and the polygon it holds
+        size_t memoryUsage() const;
+
+    private:
+
+        //marks the cells touched by the edge from a to b
+        void markEdge(const sf::Vector2f& a, const sf::Vector2f& b);
+
+        Polygon _polygon;
+
+        //top left corner of the grid
+        sf::Vector2f _origin;
+        float _cellSize;
+        float _invCellSize;
+        size_t _columns;
+        size_t _rows;
+        size_t _boundaryCount;
+
+        //row major, one Cell per byte
+        std::vector<uint8_t> _cells;
+};
+
+} // !namespace inclusion
+
+#endif // INCLUSION_COVERAGEMASK_HPP
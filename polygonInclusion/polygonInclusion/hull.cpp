@@ -0,0 +1,164 @@
+#include "hull.hpp"
+#include "orientation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+namespace inclusion
+{
+
+namespace
+{
+
+//below this many points per thread, starting the threads costs more than it saves
+const size_t minChunkSize = 1 << 16;
+
+bool lessXY(const sf::Vector2f& a, const sf::Vector2f& b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+//Andrew's monotone chain over distinct points sorted by lessXY
+void monotoneChain(const std::vector<sf::Vector2f>& sorted, std::vector<sf::Vector2f>& hull)
+{
+    const size_t n = sorted.size();
+    hull.resize(2 * n + 1);
+    size_t k = 0;
+
+    //lower chain, from left to right
+    for (size_t i = 0; i < n; ++i)
+    {
+        while (k >= 2 && orientation(hull[k - 2], hull[k - 1], sorted[i]) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = sorted[i];
+    }
+
+    //upper chain, back from right to left
+    const size_t lower = k + 1;
+    for (size_t i = n; i-- > 1;)
+    {
+        while (k >= lower && orientation(hull[k - 2], hull[k - 1], sorted[i - 1]) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = sorted[i - 1];
+    }
+
+    //the first point closes the upper chain
+    hull.resize(k > 1 ? k - 1 : k);
+}
+
+typedef std::vector<sf::Vector2f>::const_iterator PointIterator;
+
+//true only if c is left of the line a>b for certain, with the same error bound as the
+//fast path of orientation. The points it is not sure about are kept for the hull
+bool surelyLeft(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c)
+{
+    const double left = (static_cast<double>(a.x) - c.x) * (static_cast<double>(b.y) - c.y);
+    const double right = (static_cast<double>(a.y) - c.y) * (static_cast<double>(b.x) - c.x);
+    return left - right > 3.4e-16 * (std::abs(left) + std::abs(right));
+}
+
+//hull of the points [begin, end)
+void chunkHull(PointIterator begin, PointIterator end, std::vector<sf::Vector2f>& hull)
+{
+    std::vector<sf::Vector2f> kept;
+    if (begin != end)
+    {
+        //quadrilateral of the leftmost, lowest, rightmost and highest points, counter
+        //clockwise. The points strictly inside it can not be on the hull
+        sf::Vector2f left = *begin, bottom = *begin, right = *begin, top = *begin;
+        for (PointIterator it = begin; it != end; ++it)
+        {
+            if (it->x < left.x)
+            {
+                left = *it;
+            }
+            if (it->y < bottom.y)
+            {
+                bottom = *it;
+            }
+            if (it->x > right.x)
+            {
+                right = *it;
+            }
+            if (it->y > top.y)
+            {
+                top = *it;
+            }
+        }
+
+        for (PointIterator it = begin; it != end; ++it)
+        {
+            if (!surelyLeft(left, bottom, *it) || !surelyLeft(bottom, right, *it)
+                || !surelyLeft(right, top, *it) || !surelyLeft(top, left, *it))
+            {
+                kept.push_back(*it);
+            }
+        }
+    }
+
+    std::sort(kept.begin(), kept.end(), lessXY);
+    kept.erase(std::unique(kept.begin(), kept.end()), kept.end());
+    monotoneChain(kept, hull);
+}
+
+} // !namespace
+
+std::vector<sf::Vector2f> convexHull(const std::vector<sf::Vector2f>& points, size_t threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min(threads, points.size() / minChunkSize));
+
+    std::vector<std::vector<sf::Vector2f>> hulls(threads);
+    const size_t chunk = (points.size() + threads - 1) / threads;
+
+    //the calling thread takes the first chunk
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t)
+    {
+        PointIterator begin = points.begin() + std::min(points.size(), t * chunk);
+        PointIterator end = points.begin() + std::min(points.size(), (t + 1) * chunk);
+        workers.push_back(std::thread(chunkHull, begin, end, std::ref(hulls[t])));
+    }
+    chunkHull(points.begin(), points.begin() + std::min(points.size(), chunk), hulls[0]);
+    for (size_t t = 0; t < workers.size(); ++t)
+    {
+        workers[t].join();
+    }
+
+    if (threads == 1)
+    {
+        return hulls[0];
+    }
+
+    //the hull of the hulls of the chunks is the hull of all the points
+    std::vector<sf::Vector2f> merged;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        merged.insert(merged.end(), hulls[t].begin(), hulls[t].end());
+    }
+    std::vector<sf::Vector2f> hull;
+    chunkHull(merged.cbegin(), merged.cend(), hull);
+    return hull;
+}
+
+sf::ConvexShape convexHullShape(const std::vector<sf::Vector2f>& points, size_t threads)
+{
+    std::vector<sf::Vector2f> hull = convexHull(points, threads);
+    sf::ConvexShape shape(hull.size());
+    for (size_t i = 0; i < hull.size(); ++i)
+    {
+        shape.setPoint(i, hull[i]);
+    }
+    return shape;
+}
+
+} // !namespace inclusion
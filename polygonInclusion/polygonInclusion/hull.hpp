@@ -0,0 +1,27 @@
+#ifndef INCLUSION_HULL_HPP
+#define INCLUSION_HULL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace inclusion
+{
+
+//convex hull of points in any order, counter clockwise like ConvexPolygon, starting
+//from the point with the lowest x (then lowest y)
+//points aligned on the border are dropped, so a set of aligned points gives
+//fewer than 3 points
+//the points are split in one chunk per thread. Each thread drops the points inside
+//the quadrilateral of the extreme points of its chunk, sorts the others and builds
+//their hull with a monotone chain, and the hulls of the chunks are merged at the end
+//threads = 0 uses one thread per core, small inputs always run on the calling thread
+std::vector<sf::Vector2f> convexHull(const std::vector<sf::Vector2f>& points, size_t threads = 0);
+
+//shape whose points are the hull of points, ready for ConvexPolygon and the SAT tests
+sf::ConvexShape convexHullShape(const std::vector<sf::Vector2f>& points, size_t threads = 0);
+
+} // !namespace inclusion
+
+#endif // INCLUSION_HULL_HPP
@@ -0,0 +1,114 @@
+#include "inclusion.hpp"
+
+namespace inclusion
+{
+
+bool contains(const sf::ConvexShape& shape, sf::Vector2f point)
+{
+    size_t minyi = 0, maxyi = 0;
+    float miny = shape.getPoint(0).y;
+    float maxy = miny;
+
+    //the point is moved to the local space of the shape, the vertices are left untouched
+    point = shape.getInverseTransform().transformPoint(point);
+
+    for(size_t i = 0; i < shape.getPointCount(); ++i)
+    {
+        float y = shape.getPoint(i).y;
+        if(y < miny)
+        {
+            minyi = i;
+            miny = y;
+        }
+        else if(y > maxy)
+        {
+            maxyi = i;
+            maxy = y;
+        }
+    }
+
+    if(point.y < miny || point.y > maxy)
+    {
+        return false;
+    }
+
+    //find the two segments that surround the point in y axis
+    //first going right side
+    size_t rightSide1 = minyi, leftSide1 = minyi;
+    size_t rightSide2 = minyi, leftSide2 = minyi;
+    int i = minyi;
+    int ip1;
+    while(i != maxyi)
+    {
+        ip1 = i+1;
+        if(ip1 >= shape.getPointCount())
+        {
+            ip1 = 0;
+        }
+
+        int minYtmp, maxYtmp;
+        if(shape.getPoint(i).y < shape.getPoint(ip1).y)
+        {
+            minYtmp = i;
+            maxYtmp = ip1;
+        }
+        else
+        {
+            maxYtmp = i;
+            minYtmp = ip1;
+        }
+
+        if(point.y >= shape.getPoint(minYtmp).y && point.y <= shape.getPoint(maxYtmp).y)
+        {
+            rightSide1 = minYtmp;
+            rightSide2 = maxYtmp;
+        }
+        ++i;
+        if(i >= shape.getPointCount())
+        {
+            i = 0;
+        }
+    }
+
+    //leftSide
+    i = minyi;
+    while(i != maxyi)
+    {
+        ip1 = i-1;
+        if(ip1 < 0)
+        {
+            ip1 = shape.getPointCount()-1;
+        }
+
+        int minYtmp, maxYtmp;
+        if(shape.getPoint(i).y < shape.getPoint(ip1).y)
+        {
+            minYtmp = i;
+            maxYtmp = ip1;
+        }
+        else
+        {
+            maxYtmp = i;
+            minYtmp = ip1;
+        }
+
+        if(point.y >= shape.getPoint(minYtmp).y && point.y <= shape.getPoint(maxYtmp).y)
+        {
+            leftSide1 = minYtmp;
+            leftSide2 = maxYtmp;
+        }
+        --i;
+        if(i < 0)
+        {
+            i = shape.getPointCount()-1;
+        }
+    }
+
+    return (isLeft(shape.getPoint(rightSide1), shape.getPoint(rightSide2), point) >= 0
+        && isLeft(shape.getPoint(leftSide1), shape.getPoint(leftSide2), point) <= 0)
+        ||
+        (isLeft(shape.getPoint(rightSide1), shape.getPoint(rightSide2), point) <= 0
+        && isLeft(shape.getPoint(leftSide1), shape.getPoint(leftSide2), point) >= 0);
+}
+
+} // !namespace inclusion
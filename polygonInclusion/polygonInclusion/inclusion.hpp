@@ -0,0 +1,64 @@
+#ifndef INCLUSION_INCLUSION_HPP
+#define INCLUSION_INCLUSION_HPP
+
+#include <cmath>
+
+#include <SFML/Graphics.hpp>
+
+#include "orientation.hpp"
+
+namespace inclusion
+{
+
+template <typename T>
+float norm2(const sf::Vector2<T>& a)
+{
+    return static_cast<float>(a.x*a.x + a.y*a.y);
+}
+
+template <typename T>
+float norm(const sf::Vector2<T>& a)
+{
+    return std::sqrt(norm2(a));
+}
+
+template <typename T>
+sf::Vector2<T> normalize(const sf::Vector2<T>& vec)
+{
+    T n = norm(vec);
+    return sf::Vector2<T>(T(vec.x / n), T(vec.y / n));
+}
+
+template <typename T>
+T dot(const sf::Vector2<T>& a, const sf::Vector2<T>& b) {
+    return a.x*b.x + a.y*b.y;
+}
+
+//z component of the cross product, >0 if b is counter clockwise from a (y up)
+template <typename T>
+T cross(const sf::Vector2<T>& a, const sf::Vector2<T>& b) {
+    return a.x*b.y - a.y*b.x;
+}
+
+//line define by P0>P1
+//tests if P2 is left
+///returns >0 if left, 0 if on the line, <0 if right
+template <typename T>
+T isLeft(const sf::Vector2<T>& p0, const sf::Vector2<T>& p1, const sf::Vector2<T>& p2)
+{
+    return (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+}
+
+//the float version only returns the sign, 1, 0 or -1, which is always exact
+inline float isLeft(const sf::Vector2f& p0, const sf::Vector2f& p1, const sf::Vector2f& p2)
+{
+    return static_cast<float>(orientation(p0, p1, p2));
+}
+
+//walks both chains of shape between its lowest and highest points, O(n) per call
+//point is in world space, it is mapped through the inverse transform of shape
+bool contains(const sf::ConvexShape& shape, sf::Vector2f point);
+
+} // !namespace inclusion
+
+#endif // INCLUSION_INCLUSION_HPP
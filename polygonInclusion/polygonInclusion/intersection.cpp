@@ -0,0 +1,313 @@
+#include "intersection.hpp"
+#include "inclusion.hpp"
+
+#include <algorithm>
+
+namespace inclusion
+{
+
+namespace
+{
+
+//receives the vertices of the intersection one at a time, skipping repeated ones,
+//and sums the shoelace area on the way
+template <typename Sink>
+class Builder
+{
+    public:
+
+        explicit Builder(Sink& sink) : _sink(sink), _count(0), _area(0.0)
+        {
+        }
+
+        void add(const sf::Vector2f& p)
+        {
+            if (_count > 0 && (p == _last || p == _first))
+            {
+                return;
+            }
+            if (_count == 0)
+            {
+                _first = p;
+            }
+            else
+            {
+                _area += static_cast<double>(_last.x) * p.y - static_cast<double>(p.x) * _last.y;
+            }
+            _last = p;
+            ++_count;
+            _sink.add(p);
+        }
+
+        void clear()
+        {
+            _count = 0;
+            _area = 0.0;
+            _sink.clear();
+        }
+
+        //closes the border, less than 3 vertices is no area at all
+        float finish()
+        {
+            if (_count < 3)
+            {
+                clear();
+                return 0.0f;
+            }
+            _area += static_cast<double>(_last.x) * _first.y - static_cast<double>(_first.x) * _last.y;
+            return static_cast<float>(_area * 0.5);
+        }
+
+    private:
+
+        Sink& _sink;
+        sf::Vector2f _first;
+        sf::Vector2f _last;
+        size_t _count;
+        double _area;
+};
+
+struct VectorSink
+{
+    explicit VectorSink(std::vector<sf::Vector2f>& points) : points(points)
+    {
+    }
+
+    void add(const sf::Vector2f& p)
+    {
+        points.push_back(p);
+    }
+
+    void clear()
+    {
+        points.clear();
+    }
+
+    std::vector<sf::Vector2f>& points;
+};
+
+struct NullSink
+{
+    void add(const sf::Vector2f&)
+    {
+    }
+
+    void clear()
+    {
+    }
+};
+
+enum Crossing
+{
+    NoCrossing,
+    //the segments cross at a point inside both of them
+    Proper,
+    //an endpoint of a segment is on the other one
+    Vertex,
+    //the segments are aligned and overlap
+    Overlap
+};
+
+//crossing of the segments a0>a1 and b0>b1, p receives the crossing point
+//oa1 and ob1 are the sides of a1 and b1, orientation(b0, b1, a1) and orientation(a0, a1, b1)
+Crossing crossSegments(const sf::Vector2f& a0, const sf::Vector2f& a1, const sf::Vector2f& b0, const sf::Vector2f& b1, int oa1, int ob1, sf::Vector2f& p)
+{
+    const int oa0 = orientation(b0, b1, a0);
+    if (oa0 * oa1 > 0)
+    {
+        return NoCrossing;
+    }
+    const int ob0 = orientation(a0, a1, b0);
+
+    if (oa0 == 0 && oa1 == 0)
+    {
+        //aligned, they overlap if b0 or b1 is inside a0>a1, or a0 inside b0>b1
+        const sf::Vector2f d = a1 - a0;
+        const float t0 = dot(b0 - a0, d);
+        const float t1 = dot(b1 - a0, d);
+        const float length = dot(d, d);
+        const bool overlap = std::max(t0, t1) >= 0.0f && std::min(t0, t1) <= length;
+        return overlap ? Overlap : NoCrossing;
+    }
+    if (ob0 * ob1 > 0)
+    {
+        return NoCrossing;
+    }
+    if (oa0 == 0 || oa1 == 0 || ob0 == 0 || ob1 == 0)
+    {
+        p = oa0 == 0 ? a0 : (oa1 == 0 ? a1 : (ob0 == 0 ? b0 : b1));
+        return Vertex;
+    }
+
+    const double ax = a1.x - static_cast<double>(a0.x), ay = a1.y - static_cast<double>(a0.y);
+    const double bx = b1.x - static_cast<double>(b0.x), by = b1.y - static_cast<double>(b0.y);
+    const double t = ((b0.x - static_cast<double>(a0.x)) * by - (b0.y - static_cast<double>(a0.y)) * bx) / (ax * by - ay * bx);
+    p = sf::Vector2f(static_cast<float>(a0.x + t * ax), static_cast<float>(a0.y + t * ay));
+    return Proper;
+}
+
+//true if every point of a is in b, border included
+bool inside(const ConvexPolygon& a, const ConvexPolygon& b)
+{
+    const std::vector<sf::Vector2f>& points = a.getPoints();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        if (!b.contains(points[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Sink>
+float intersect(const ConvexPolygon& pa, const ConvexPolygon& pb, Sink& sink)
+{
+    enum Inside
+    {
+        Unknown,
+        AInside,
+        BInside
+    };
+
+    Builder<Sink> out(sink);
+    out.clear();
+
+    const std::vector<sf::Vector2f>& P = pa.getPoints();
+    const std::vector<sf::Vector2f>& Q = pb.getPoints();
+    const size_t n = P.size();
+    const size_t m = Q.size();
+    if (n < 3 || m < 3)
+    {
+        return 0.0f;
+    }
+    const sf::FloatRect& ba = pa.getBounds();
+    const sf::FloatRect& bb = pb.getBounds();
+    if (ba.left > bb.left + bb.width || bb.left > ba.left + ba.width
+        || ba.top > bb.top + bb.height || bb.top > ba.top + ba.height)
+    {
+        return 0.0f;
+    }
+
+    //a and b are the current edges P[a-1]>P[a] and Q[b-1]>Q[b], advanced
+    //respectively advancedA and advancedB times
+    size_t a = 0, b = 0;
+    size_t advancedA = 0, advancedB = 0;
+    Inside in = Unknown;
+    bool crossed = false;
+    do
+    {
+        const sf::Vector2f& a0 = P[a == 0 ? n - 1 : a - 1];
+        const sf::Vector2f& a1 = P[a];
+        const sf::Vector2f& b0 = Q[b == 0 ? m - 1 : b - 1];
+        const sf::Vector2f& b1 = Q[b];
+
+        //turn from edge a to edge b, and the side of each edge the head of the other is on
+        const int turn = orientation(sf::Vector2f(0.0f, 0.0f), a1 - a0, b1 - b0);
+        const int aSide = orientation(b0, b1, a1);
+        const int bSide = orientation(a0, a1, b1);
+
+        sf::Vector2f p;
+        const Crossing crossing = crossSegments(a0, a1, b0, b1, aSide, bSide, p);
+        if (crossing == Proper || crossing == Vertex)
+        {
+            if (!crossed)
+            {
+                //the vertices passed before the first crossing are not counted, the
+                //loop has to go around both polygons once from there
+                crossed = true;
+                advancedA = advancedB = 0;
+            }
+            out.add(p);
+            if (aSide > 0)
+            {
+                in = AInside;
+            }
+            else if (bSide > 0)
+            {
+                in = BInside;
+            }
+        }
+
+        if (crossing == Overlap && dot(a1 - a0, b1 - b0) < 0.0f)
+        {
+            //edges going opposite ways along the same line, the polygons only touch
+            out.clear();
+            return 0.0f;
+        }
+
+        bool advanceA;
+        if (turn == 0 && aSide < 0 && bSide < 0)
+        {
+            //parallel edges with each polygon outside of the other one
+            out.clear();
+            return 0.0f;
+        }
+        else if (turn == 0 && aSide == 0 && bSide == 0)
+        {
+            //aligned edges going the same way, the one outside is skipped
+            advanceA = in != AInside;
+        }
+        else if (turn >= 0)
+        {
+            advanceA = bSide > 0;
+        }
+        else
+        {
+            advanceA = aSide <= 0;
+        }
+
+        if (advanceA)
+        {
+            if (in == AInside)
+            {
+                out.add(a1);
+            }
+            a = a + 1 == n ? 0 : a + 1;
+            ++advancedA;
+        }
+        else
+        {
+            if (in == BInside)
+            {
+                out.add(b1);
+            }
+            b = b + 1 == m ? 0 : b + 1;
+            ++advancedB;
+        }
+    } while ((advancedA < n || advancedB < m) && advancedA < 2 * n && advancedB < 2 * m);
+
+    if (in != Unknown)
+    {
+        return out.finish();
+    }
+
+    //the borders never crossed, one polygon holds the other or they do not overlap
+    out.clear();
+    const ConvexPolygon* inner = inside(pa, pb) ? &pa : (inside(pb, pa) ? &pb : nullptr);
+    if (inner)
+    {
+        const std::vector<sf::Vector2f>& points = inner->getPoints();
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            out.add(points[i]);
+        }
+    }
+    return out.finish();
+}
+
+} // !namespace
+
+float intersection(const ConvexPolygon& a, const ConvexPolygon& b, std::vector<sf::Vector2f>& out)
+{
+    VectorSink sink(out);
+    return intersect(a, b, sink);
+}
+
+float intersectionArea(const ConvexPolygon& a, const ConvexPolygon& b)
+{
+    NullSink sink;
+    return intersect(a, b, sink);
+}
+
+} // !namespace inclusion
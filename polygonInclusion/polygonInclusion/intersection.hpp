@@ -0,0 +1,27 @@
+#ifndef INCLUSION_INTERSECTION_HPP
+#define INCLUSION_INTERSECTION_HPP
+
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "convexpolygon.hpp"
+
+namespace inclusion
+{
+
+//region shared by two convex polygons, in O(n+m)
+//the edges of both borders are advanced together like in O'Rourke's algorithm,
+//the one that is behind the other is moved forward, and every crossing of the borders
+//is a vertex of the intersection along with the vertices of the border inside
+//out receives the intersection counter clockwise, empty if the polygons only touch
+//or do not overlap. It is cleared first and reused without allocating once it is
+//large enough. Returns the area of the intersection
+float intersection(const ConvexPolygon& a, const ConvexPolygon& b, std::vector<sf::Vector2f>& out);
+
+//area of the intersection of a and b without building it, never allocates
+float intersectionArea(const ConvexPolygon& a, const ConvexPolygon& b);
+
+} // !namespace inclusion
+
+#endif // INCLUSION_INTERSECTION_HPP
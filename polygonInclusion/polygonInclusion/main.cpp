@@ -1,9 +1,15 @@
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <array>
 
 #include <SFML/Graphics.hpp>
 
+#include "inclusion.hpp"
+#include "transformedpolygon.hpp"
+#include "hull.hpp"
+#include "profiler.hpp"
+
 #define WIDTH   640
 #define HEIGHT  480
 
@@ -42,8 +48,6 @@ void drawLine(sf::RenderTarget& window, const sf::Vector2f& p1, const sf::Vector
     points[2] = points[0];
 
     window.draw(points, 3, sf::LinesStrip);
-
-    delete[] points;
 }
 
 template <typename T>
@@ -51,151 +55,21 @@ float getAngleBetweenVectors(const sf::Vector2<T>& o, const sf::Vector2<T>& v) {
     return (float)-(atan2(static_cast<double>(o.y), static_cast<double>(o.x)) - atan2(static_cast<double>(v.y), static_cast<double>(v.x)));
 }
 
-template <typename T>
-float norm2(const sf::Vector2<T>& a)
-{
-    return static_cast<float>(a.x*a.x + a.y*a.y);
-}
-
-template <typename T>
-float norm(const sf::Vector2<T>& a)
-{
-    return sqrt(norm2(a));
-}
-
-template <typename T>
-sf::Vector2<T> normalize(const sf::Vector2<T>& vec)
-{
-    T n = norm(vec);
-    return sf::Vector2<T>(T(vec.x / n), T(vec.y / n));
-}
-
-template <typename T>
-T dot(const sf::Vector2<T>& a, const sf::Vector2<T>& b) {
-    return a.x*b.x + a.y*b.y;
-}
-
-//line define by P0>P1
-//tests if P2 is left
-///returns >0 if left, 0 if on the line, <0 if right
-template <typename T>
-T isLeft(const sf::Vector2<T>& p0, const sf::Vector2<T>& p1, const sf::Vector2<T>& p2)
-{
-    if(p0.y < p1.y)
-        return ( (p1.x - p0.x) * (p2.y - p0.y) - (p2.x -  p0.x) * (p1.y - p0.y) );
-    else
-        return ( (p0.x - p1.x) * (p2.y - p1.y) - (p2.x -  p1.x) * (p0.y - p1.y) );
-}
-
-bool contains(const sf::ConvexShape& shape, sf::Vector2f point)
+//usage : polygonInclusion [--profile file.csv]
+//--profile writes the time of every stage of every frame to a CSV file
+//F10 shows the profiler, F11 writes its last frames to profile.csv
+int main(int argc, char** argv)
 {
-    size_t minyi = 0, maxyi = 0;
-    float miny = shape.getPoint(0).y;
-    float maxy = miny;
-
-    point = point - shape.getPosition();
-
-    for(size_t i = 0; i < shape.getPointCount(); ++i)
+    std::string profileFile;
+    for (int i = 1; i < argc; ++i)
     {
-        float y = shape.getPoint(i).y;
-        if(y < miny)
-        {
-            minyi = i;
-            miny = y;
-        }
-        else if(y > maxy)
+        if (!sandbox::parseProfileArgument(argc, argv, i, profileFile))
         {
-            maxyi = i;
-            maxy = y;
+            std::cerr << "usage : " << argv[0] << " [--profile file.csv]" << std::endl;
+            return 1;
         }
     }
 
-    if(point.y < miny || point.y > maxy)
-    {
-        return false;
-    }
-
-    //find the two segments that surround the point in y axis
-    //first going right side
-    size_t rightSide1 = minyi, leftSide1 = minyi;
-    size_t rightSide2 = minyi, leftSide2 = minyi;
-    int i = minyi;
-    int ip1;
-    while(i != maxyi)
-    {
-        ip1 = i+1;
-        if(ip1 >= shape.getPointCount())
-        {
-            ip1 = 0;
-        }
-
-        int minYtmp, maxYtmp;
-        if(shape.getPoint(i).y < shape.getPoint(ip1).y)
-        {
-            minYtmp = i;
-            maxYtmp = ip1;
-        }
-        else
-        {
-            maxYtmp = i;
-            minYtmp = ip1;
-        }
-
-        if(point.y >= shape.getPoint(minYtmp).y && point.y <= shape.getPoint(maxYtmp).y)
-        {
-            rightSide1 = minYtmp;
-            rightSide2 = maxYtmp;
-        }
-        ++i;
-        if(i >= shape.getPointCount())
-        {
-            i = 0;
-        }
-    }
-
-    //leftSide
-    i = minyi;
-    while(i != maxyi)
-    {
-        ip1 = i-1;
-        if(ip1 < 0)
-        {
-            ip1 = shape.getPointCount()-1;
-        }
-
-        int minYtmp, maxYtmp;
-        if(shape.getPoint(i).y < shape.getPoint(ip1).y)
-        {
-            minYtmp = i;
-            maxYtmp = ip1;
-        }
-        else
-        {
-            maxYtmp = i;
-            minYtmp = ip1;
-        }
-
-        if(point.y >= shape.getPoint(minYtmp).y && point.y <= shape.getPoint(maxYtmp).y)
-        {
-            leftSide1 = minYtmp;
-            leftSide2 = maxYtmp;
-        }
-        --i;
-        if(i < 0)
-        {
-            i = shape.getPointCount()-1;
-        }
-    }
-
-    return (isLeft(shape.getPoint(rightSide1), shape.getPoint(rightSide2), point) >= 0
-        && isLeft(shape.getPoint(leftSide1), shape.getPoint(leftSide2), point) <= 0)
-        ||
-        (isLeft(shape.getPoint(rightSide1), shape.getPoint(rightSide2), point) <= 0
-        && isLeft(shape.getPoint(leftSide1), shape.getPoint(leftSide2), point) >= 0);
-}
-
-int main(int argc, char** argv)
-{
     /** SFML STUFF **/
 
     sf::RenderWindow window(sf::VideoMode(WIDTH, HEIGHT), "Polygon inclusion test");
@@ -205,7 +79,16 @@ int main(int argc, char** argv)
 
     sf::Vector2f mouseClick;
 
-    sf::ConvexShape shape;
+    //the points can be given in any order, the hull gives them back counter clockwise
+    std::vector<sf::Vector2f> cloud;
+    cloud.push_back(sf::Vector2f(60,100));
+    cloud.push_back(sf::Vector2f(40,-140));
+    cloud.push_back(sf::Vector2f(-90,50));
+    cloud.push_back(sf::Vector2f(120,0));
+    cloud.push_back(sf::Vector2f(60,-80));
+    cloud.push_back(sf::Vector2f(120,-40));
+    cloud.push_back(sf::Vector2f(20,10));
+    sf::ConvexShape shape = inclusion::convexHullShape(cloud);
 
     shape.setFillColor(sf::Color::Red);
     colors[0] = sf::Color::Green;
@@ -214,31 +97,26 @@ int main(int argc, char** argv)
     colors[3] = sf::Color::Red;
     colors[4] = sf::Color::Red;
     colors[5] = sf::Color::Red;
-    shape.setPointCount(6);
-    bool cw = false;
-    if(cw)
-    {
-        shape.setPoint(0, sf::Vector2f(40,-140));
-        shape.setPoint(1, sf::Vector2f(120,-40));
-        shape.setPoint(2, sf::Vector2f(120,0));
-        shape.setPoint(3, sf::Vector2f(60,100));
-        shape.setPoint(4, sf::Vector2f(-90,50));
-        shape.setPoint(5, sf::Vector2f(60,-80));
-    }
-    else
+    shape.setPosition(WIDTH/2, HEIGHT/2);
+
+    //the local points are prepared once, only the inverse transform follows the shape
+    inclusion::TransformedPolygon polygon(shape);
+
+    //the sleep at the end of the frame is in none of the stages
+    sandbox::Profiler profiler;
+    const size_t eventStage = profiler.addStage("events", sf::Color(170, 170, 170));
+    const size_t updateStage = profiler.addStage("update", sf::Color(220, 50, 50));
+    const size_t drawStage = profiler.addStage("draw", sf::Color(70, 130, 230));
+    sandbox::ProfilerOverlay overlay(profiler, sf::FloatRect(20.0f, 20.0f, 240.0f, 80.0f));
+    if (!profiler.startStream(profileFile))
     {
-        shape.setPoint(5, sf::Vector2f(40,-140));
-        shape.setPoint(4, sf::Vector2f(120,-40));
-        shape.setPoint(3, sf::Vector2f(120,0));
-        shape.setPoint(2, sf::Vector2f(60,100));
-        shape.setPoint(1, sf::Vector2f(-90,50));
-        shape.setPoint(0, sf::Vector2f(60,-80));
+        return 1;
     }
-    shape.setPosition(WIDTH/2, HEIGHT/2);
 
     //the loop
     while (window.isOpen())
     {
+        sandbox::ScopedStage eventTime(profiler, eventStage);
         sf::Event event;
         while (window.pollEvent(event))
         {
@@ -248,33 +126,62 @@ int main(int argc, char** argv)
             }
             else if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased)
             {
-                bool down = (event.type == sf::Event::KeyPressed);
+                profiler.handleKey(event);
                 switch (event.key.code)
                 {
                     case sf::Keyboard::Escape:
                         window.close();
                         break;
+
+                    default: break;
                 }
             }
         }
+        eventTime.stop();
+
+        sandbox::ScopedStage updateTime(profiler, updateStage);
+
+        //left and right rotate the shape, up and down scale it
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
+        {
+            shape.rotate(-2.0f);
+        }
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
+        {
+            shape.rotate(2.0f);
+        }
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
+        {
+            shape.scale(1.02f, 1.02f);
+        }
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
+        {
+            shape.scale(1.0f / 1.02f, 1.0f / 1.02f);
+        }
+        polygon.update(shape);
 
         sf::Vector2f mouse(sf::Mouse::getPosition(window).x, sf::Mouse::getPosition(window).y);
 
         sf::Color c(sf::Color::Blue);
-        if(contains(shape, mouse))
+        if(polygon.contains(mouse))
         {
             c = sf::Color::Green;
         }
+        updateTime.stop();
 
+        sandbox::ScopedStage drawTime(profiler, drawStage);
         window.clear({ 127, 127, 127 });
         sf::Color c2 = shape.getFillColor();
-        if(isLeft(shape.getPoint(0) + shape.getPosition(), shape.getPoint(1) + shape.getPosition(), mouse)>0)
+        if(inclusion::isLeft(shape.getPoint(0) + shape.getPosition(), shape.getPoint(1) + shape.getPosition(), mouse)>0)
         {
             c2 = sf::Color::White;
         }
         drawShape(window, shape);
         drawLine(window, sf::Vector2f(WIDTH/2, HEIGHT/2), mouse, c);
+        drawTime.stop();
+        window.draw(overlay);
         window.display();
+        profiler.endFrame();
 
         sf::sleep(sf::milliseconds(16));
 
@@ -0,0 +1,141 @@
+#include "orientation.hpp"
+
+#ifdef INCLUSION_ORIENTATION_STATS
+    #include <atomic>
+#endif
+
+namespace inclusion
+{
+
+namespace
+{
+
+#ifdef INCLUSION_ORIENTATION_STATS
+//shared by the threads, a relaxed increment is enough for counters
+std::atomic<uint64_t> calls(0);
+std::atomic<uint64_t> exactCalls(0);
+#endif
+
+//half an ulp of 1.0 in double precision
+const double epsilon = 1.1102230246251565e-16;
+
+//relative bound of the error of the determinant computed in double precision
+//from the error analysis of J. R. Shewchuk's orient2d
+const double errorBound = (3.0 + 16.0 * epsilon) * epsilon;
+
+//x + y = a + b exactly, x being the rounded sum
+void twoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+//sign of the exact sum of terms, which are destroyed
+int exactSign(double* terms, int count)
+{
+    //grows an expansion, a sum of components that do not overlap ordered by
+    //increasing magnitude, one term at a time
+    double expansion[6];
+    int length = 0;
+    for (int t = 0; t < count; ++t)
+    {
+        double q = terms[t];
+        for (int i = 0; i < length; ++i)
+        {
+            twoSum(q, expansion[i], q, expansion[i]);
+        }
+        expansion[length++] = q;
+    }
+
+    //the largest nonzero component gives the sign of the sum
+    for (int i = length - 1; i >= 0; --i)
+    {
+        if (expansion[i] != 0.0)
+        {
+            return expansion[i] > 0.0 ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+int exactOrientation(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c)
+{
+    //(a - c) x (b - c) expanded, the c.x * c.y terms cancel out
+    //the product of two floats always fits in a double, so every term is exact
+    const double ax = a.x, ay = a.y, bx = b.x, by = b.y, cx = c.x, cy = c.y;
+    double terms[6] =
+    {
+        ax * by, -ax * cy, -cx * by,
+        -ay * bx, ay * cx, cy * bx
+    };
+    return exactSign(terms, 6);
+}
+
+} // !namespace
+
+int orientation(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c)
+{
+#ifdef INCLUSION_ORIENTATION_STATS
+    calls.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+    const double left = (static_cast<double>(a.x) - c.x) * (static_cast<double>(b.y) - c.y);
+    const double right = (static_cast<double>(a.y) - c.y) * (static_cast<double>(b.x) - c.x);
+    const double det = left - right;
+
+    //the sign is certain when both products do not have the same sign
+    double sum;
+    if (left > 0.0)
+    {
+        if (right <= 0.0)
+        {
+            return det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+        }
+        sum = left + right;
+    }
+    else if (left < 0.0)
+    {
+        if (right >= 0.0)
+        {
+            return det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+        }
+        sum = -left - right;
+    }
+    else
+    {
+        return det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+    }
+
+    const double bound = errorBound * sum;
+    if (det >= bound || -det >= bound)
+    {
+        return det > 0.0 ? 1 : -1;
+    }
+
+#ifdef INCLUSION_ORIENTATION_STATS
+    exactCalls.fetch_add(1, std::memory_order_relaxed);
+#endif
+    return exactOrientation(a, b, c);
+}
+
+OrientationStats getOrientationStats()
+{
+    OrientationStats stats;
+#ifdef INCLUSION_ORIENTATION_STATS
+    stats.calls = calls.load(std::memory_order_relaxed);
+    stats.exactCalls = exactCalls.load(std::memory_order_relaxed);
+#endif
+    return stats;
+}
+
+void resetOrientationStats()
+{
+#ifdef INCLUSION_ORIENTATION_STATS
+    calls.store(0, std::memory_order_relaxed);
+    exactCalls.store(0, std::memory_order_relaxed);
+#endif
+}
+
+} // !namespace inclusion
@@ -0,0 +1,43 @@
+#ifndef INCLUSION_ORIENTATION_HPP
+#define INCLUSION_ORIENTATION_HPP
+
+#include <cstdint>
+
+#include <SFML/Graphics.hpp>
+
+namespace inclusion
+{
+
+struct OrientationStats
+{
+    OrientationStats() : calls(0), exactCalls(0)
+    {
+    }
+
+    uint64_t calls;
+    //calls where the rounding error could have changed the sign, and the
+    //determinant was computed exactly
+    uint64_t exactCalls;
+
+    float exactRate() const
+    {
+        return calls ? static_cast<float>(exactCalls) / calls : 0.0f;
+    }
+};
+
+//sign of cross(b - a, c - a) : 1 if c is left of the line a>b (counter clockwise,
+//y up), -1 if it is right and 0 if the three points are exactly aligned
+//the determinant is first computed in double precision, and its sign is kept when
+//it is larger than the bound of the rounding error. Otherwise it is computed again
+//exactly as a sum of floating point expansions, so the result is always correct
+int orientation(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c);
+
+//counts of the calls to orientation made by every thread since the last reset
+//they are only kept when INCLUSION_ORIENTATION_STATS is defined, and stay 0 otherwise
+OrientationStats getOrientationStats();
+
+void resetOrientationStats();
+
+} // !namespace inclusion
+
+#endif // INCLUSION_ORIENTATION_HPP
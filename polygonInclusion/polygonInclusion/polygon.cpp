@@ -0,0 +1,283 @@
+#include "polygon.hpp"
+#include "inclusion.hpp"
+
+#include <algorithm>
+
+namespace inclusion
+{
+
+namespace
+{
+
+//true if all the turns go the same way and the border goes around only once
+bool isConvexPolygon(const std::vector<sf::Vector2f>& points)
+{
+    const size_t n = points.size();
+    if (n < 3)
+    {
+        return false;
+    }
+
+    int sign = 0;
+    float lastDx = 0.0f;
+    int directionChanges = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const sf::Vector2f& p0 = points[i];
+        const sf::Vector2f& p1 = points[(i + 1) % n];
+        const sf::Vector2f& p2 = points[(i + 2) % n];
+        int c = orientation(p0, p1, p2);
+        if (c != 0)
+        {
+            if (sign == 0)
+            {
+                sign = c;
+            }
+            else if (c != sign)
+            {
+                return false;
+            }
+        }
+
+        //a convex polygon goes left and right only once each, a star turns more
+        float dx = p1.x - p0.x;
+        if (dx != 0.0f)
+        {
+            if ((dx > 0.0f) != (lastDx > 0.0f) && lastDx != 0.0f)
+            {
+                ++directionChanges;
+            }
+            lastDx = dx;
+        }
+    }
+    return sign != 0 && directionChanges <= 2;
+}
+
+} // !namespace
+
+Polygon::Polygon() : _convex(false), _orientation(1)
+{
+}
+
+Polygon::Polygon(const sf::ConvexShape& shape) : _convex(false), _orientation(1)
+{
+    const sf::Transform& t = shape.getTransform();
+    std::vector<sf::Vector2f> points(shape.getPointCount());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        points[i] = t.transformPoint(shape.getPoint(i));
+    }
+    setPoints(points);
+}
+
+Polygon::Polygon(const std::vector<sf::Vector2f>& points) : _convex(false), _orientation(1)
+{
+    setPoints(points);
+}
+
+void Polygon::setPoints(const std::vector<sf::Vector2f>& points)
+{
+    _points = points;
+
+    _bounds = sf::FloatRect();
+    if (!_points.empty())
+    {
+        float left = _points[0].x, right = _points[0].x;
+        float top = _points[0].y, bottom = _points[0].y;
+        for (size_t i = 1; i < _points.size(); ++i)
+        {
+            left = std::min(left, _points[i].x);
+            right = std::max(right, _points[i].x);
+            top = std::min(top, _points[i].y);
+            bottom = std::max(bottom, _points[i].y);
+        }
+        _bounds = sf::FloatRect(left, top, right - left, bottom - top);
+    }
+
+    _convex = isConvexPolygon(_points);
+    _slabY.clear();
+    _slabStart.clear();
+    _slabEdges.clear();
+    if (_convex)
+    {
+        //the convex polygon is reordered counter clockwise, keep the winding of the input
+        float area = 0.0f;
+        for (size_t i = 0; i < _points.size(); ++i)
+        {
+            area += cross(_points[i], _points[(i + 1) % _points.size()]);
+        }
+        _orientation = area < 0.0f ? -1 : 1;
+        _convexPolygon.setPoints(_points);
+    }
+    else
+    {
+        _convexPolygon = ConvexPolygon();
+        buildSlabs();
+    }
+}
+
+void Polygon::buildSlabs()
+{
+    const size_t n = _points.size();
+    if (n < 3)
+    {
+        return;
+    }
+
+    std::vector<float> ys(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ys[i] = _points[i].y;
+    }
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+    if (ys.size() < 2)
+    {
+        return;
+    }
+
+    //an edge is stored in every slab it overlaps, which can add up to O(n^2) edges
+    //when a horizontal line crosses many of them. Slabs are cut at every step-th
+    //vertex y, with step doubled until the edges fit in the budget
+    const size_t budget = 16 * n;
+    size_t step = 1;
+    for (;;)
+    {
+        _slabY.clear();
+        for (size_t i = 0; i < ys.size(); i += step)
+        {
+            _slabY.push_back(ys[i]);
+        }
+        if (_slabY.back() != ys.back())
+        {
+            _slabY.push_back(ys.back());
+        }
+
+        size_t total = 0;
+        for (size_t i = 0; i < n && total <= budget; ++i)
+        {
+            const sf::Vector2f& a = _points[i];
+            const sf::Vector2f& b = _points[(i + 1) % n];
+            if (a.y != b.y)
+            {
+                total += slabRange(std::min(a.y, b.y), std::max(a.y, b.y)).second;
+            }
+        }
+        if (total <= budget || _slabY.size() <= 2)
+        {
+            break;
+        }
+        step *= 2;
+    }
+
+    //first pass counts the edges of every slab, the second one writes them
+    const size_t slabs = _slabY.size() - 1;
+    _slabStart.assign(slabs + 1, 0);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            Edge e;
+            e.a = _points[i];
+            e.b = _points[(i + 1) % n];
+            if (e.a.y == e.b.y)
+            {
+                //horizontal edges never change the winding number
+                continue;
+            }
+
+            std::pair<size_t, size_t> range = slabRange(std::min(e.a.y, e.b.y), std::max(e.a.y, e.b.y));
+            for (size_t s = range.first; s < range.first + range.second; ++s)
+            {
+                if (pass == 0)
+                {
+                    ++_slabStart[s + 1];
+                }
+                else
+                {
+                    _slabEdges[_slabStart[s]++] = e;
+                }
+            }
+        }
+
+        if (pass == 0)
+        {
+            for (size_t s = 1; s < _slabStart.size(); ++s)
+            {
+                _slabStart[s] += _slabStart[s - 1];
+            }
+            _slabEdges.resize(_slabStart.back());
+        }
+        else
+        {
+            for (size_t s = _slabStart.size() - 1; s > 0; --s)
+            {
+                _slabStart[s] = _slabStart[s - 1];
+            }
+            _slabStart[0] = 0;
+        }
+    }
+}
+
+std::pair<size_t, size_t> Polygon::slabRange(float y0, float y1) const
+{
+    //slab k is [_slabY[k], _slabY[k+1]), the edge covers [y0, y1)
+    size_t first = std::upper_bound(_slabY.begin(), _slabY.end(), y0) - _slabY.begin() - 1;
+    size_t last = std::lower_bound(_slabY.begin(), _slabY.end(), y1) - _slabY.begin();
+    return std::make_pair(first, last - first);
+}
+
+int Polygon::winding(const sf::Vector2f& point) const
+{
+    if (_convex)
+    {
+        return _convexPolygon.contains(point) ? _orientation : 0;
+    }
+
+    if (_slabY.empty() || point.y < _slabY.front() || point.y >= _slabY.back())
+    {
+        return 0;
+    }
+    size_t slab = std::upper_bound(_slabY.begin(), _slabY.end(), point.y) - _slabY.begin() - 1;
+
+    //an edge going up crosses the horizontal ray to the right of the point if the
+    //point is on its left, an edge going down if the point is on its right
+    //edges can start or end inside a slab, so their y range is still checked
+    int w = 0;
+    for (uint32_t i = _slabStart[slab]; i < _slabStart[slab + 1]; ++i)
+    {
+        const Edge& e = _slabEdges[i];
+        if (e.a.y < e.b.y)
+        {
+            if (e.a.y <= point.y && point.y < e.b.y && orientation(e.a, e.b, point) > 0)
+            {
+                ++w;
+            }
+        }
+        else if (e.b.y <= point.y && point.y < e.a.y && orientation(e.a, e.b, point) < 0)
+        {
+            --w;
+        }
+    }
+    return w;
+}
+
+bool Polygon::contains(const sf::Vector2f& point) const
+{
+    if (_convex)
+    {
+        return _convexPolygon.contains(point);
+    }
+    return winding(point) != 0;
+}
+
+size_t Polygon::memoryUsage() const
+{
+    return _points.capacity() * sizeof(sf::Vector2f)
+        + _slabY.capacity() * sizeof(float)
+        + _slabStart.capacity() * sizeof(uint32_t)
+        + _slabEdges.capacity() * sizeof(Edge)
+        + _convexPolygon.memoryUsage();
+}
+
+} // !namespace inclusion
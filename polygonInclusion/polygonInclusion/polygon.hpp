@@ -0,0 +1,109 @@
+#ifndef INCLUSION_POLYGON_HPP
+#define INCLUSION_POLYGON_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "convexpolygon.hpp"
+
+namespace inclusion
+{
+
+//polygon of any shape, concave and self intersecting ones included
+//the y axis is cut into slabs at the distinct vertex y, and every slab keeps the
+//edges that overlap it. A query finds its slab with a binary search and only computes
+//the winding number over the edges of that slab
+//slabs are merged when a horizontal line crosses so many edges that storing them
+//per slab would take more than 16 edges per vertex
+//convex polygons are detected and answered by ConvexPolygon instead
+class Polygon
+{
+    public:
+
+        Polygon();
+
+        //takes the full transform of shape into account
+        explicit Polygon(const sf::ConvexShape& shape);
+
+        explicit Polygon(const std::vector<sf::Vector2f>& points);
+
+        void setPoints(const std::vector<sf::Vector2f>& points);
+
+        //number of times the border turns around point, counter clockwise being positive
+        //0 for a point outside, always 0 or 1 for a point inside a convex polygon
+        int winding(const sf::Vector2f& point) const;
+
+        //nonzero winding rule
+        //points exactly on the border can be reported on either side
+        bool contains(const sf::Vector2f& point) const;
+
+        bool isConvex() const
+        {
+            return _convex;
+        }
+
+        //the prepared convex polygon, empty if the polygon is not convex
+        const ConvexPolygon& getConvexPolygon() const
+        {
+            return _convexPolygon;
+        }
+
+        const std::vector<sf::Vector2f>& getPoints() const
+        {
+            return _points;
+        }
+
+        const sf::FloatRect& getBounds() const
+        {
+            return _bounds;
+        }
+
+        size_t getSlabCount() const
+        {
+            return _slabY.empty() ? 0 : _slabY.size() - 1;
+        }
+
+        //number of edges stored in all the slabs, an edge is stored in every slab it spans
+        size_t getSlabEdgeCount() const
+        {
+            return _slabEdges.size();
+        }
+
+        //bytes allocated by the polygon and its convex polygon, sizeof(Polygon) not included
+        size_t memoryUsage() const;
+
+    private:
+
+        struct Edge
+        {
+            sf::Vector2f a;
+            sf::Vector2f b;
+        };
+
+        void buildSlabs();
+
+        //first slab overlapped by [y0, y1) and the number of slabs it overlaps
+        std::pair<size_t, size_t> slabRange(float y0, float y1) const;
+
+        std::vector<sf::Vector2f> _points;
+        sf::FloatRect _bounds;
+
+        bool _convex;
+        //winding of the points inside when the polygon is convex, 1 or -1
+        int _orientation;
+        ConvexPolygon _convexPolygon;
+
+        //slab k goes from _slabY[k] to _slabY[k+1], its edges are
+        //_slabEdges[_slabStart[k]] to _slabEdges[_slabStart[k+1]-1]
+        std::vector<float> _slabY;
+        std::vector<uint32_t> _slabStart;
+        std::vector<Edge> _slabEdges;
+};
+
+} // !namespace inclusion
+
+#endif // INCLUSION_POLYGON_HPP
@@ -0,0 +1,181 @@
+#include "polygonindex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace inclusion
+{
+
+PolygonIndex::PolygonIndex() : _columns(0), _rows(0), _invCellWidth(0.0f), _invCellHeight(0.0f)
+{
+}
+
+void PolygonIndex::build(const std::vector<ConvexPolygon>& polygons, float cellsPerPolygon)
+{
+    _polygons = polygons;
+    _cellStart.clear();
+    _items.clear();
+    _columns = 0;
+    _rows = 0;
+
+    //bounds of all the polygons that have points
+    bool first = true;
+    float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+    for (size_t i = 0; i < _polygons.size(); ++i)
+    {
+        if (_polygons[i].getPoints().size() < 3)
+        {
+            continue;
+        }
+        const sf::FloatRect& b = _polygons[i].getBounds();
+        if (first)
+        {
+            left = b.left;
+            top = b.top;
+            right = b.left + b.width;
+            bottom = b.top + b.height;
+            first = false;
+        }
+        else
+        {
+            left = std::min(left, b.left);
+            top = std::min(top, b.top);
+            right = std::max(right, b.left + b.width);
+            bottom = std::max(bottom, b.top + b.height);
+        }
+    }
+    if (first)
+    {
+        _bounds = sf::FloatRect();
+        return;
+    }
+    _bounds = sf::FloatRect(left, top, right - left, bottom - top);
+
+    //square cells, about cellsPerPolygon of them for each polygon
+    if (cellsPerPolygon <= 0.0f)
+    {
+        cellsPerPolygon = 1.0f;
+    }
+    const float cells = std::max(1.0f, cellsPerPolygon * _polygons.size());
+    const float width = std::max(_bounds.width, 1e-6f);
+    const float height = std::max(_bounds.height, 1e-6f);
+    const float side = std::sqrt(width * height / cells);
+    _columns = std::max<size_t>(1, static_cast<size_t>(std::ceil(width / side)));
+    _rows = std::max<size_t>(1, static_cast<size_t>(std::ceil(height / side)));
+    _invCellWidth = _columns / width;
+    _invCellHeight = _rows / height;
+
+    //first pass counts the polygons of every cell, the second one writes them
+    //in polygon order, so every cell list is sorted
+    _cellStart.assign(_columns * _rows + 1, 0);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < _polygons.size(); ++i)
+        {
+            if (_polygons[i].getPoints().size() < 3)
+            {
+                continue;
+            }
+            const sf::FloatRect& b = _polygons[i].getBounds();
+            size_t c0 = std::min(_columns - 1, static_cast<size_t>((b.left - _bounds.left) * _invCellWidth));
+            size_t c1 = std::min(_columns - 1, static_cast<size_t>((b.left + b.width - _bounds.left) * _invCellWidth));
+            size_t r0 = std::min(_rows - 1, static_cast<size_t>((b.top - _bounds.top) * _invCellHeight));
+            size_t r1 = std::min(_rows - 1, static_cast<size_t>((b.top + b.height - _bounds.top) * _invCellHeight));
+            for (size_t r = r0; r <= r1; ++r)
+            {
+                for (size_t c = c0; c <= c1; ++c)
+                {
+                    size_t cell = r * _columns + c;
+                    if (pass == 0)
+                    {
+                        ++_cellStart[cell + 1];
+                    }
+                    else
+                    {
+                        _items[_cellStart[cell]++] = static_cast<uint32_t>(i);
+                    }
+                }
+            }
+        }
+
+        if (pass == 0)
+        {
+            for (size_t c = 1; c < _cellStart.size(); ++c)
+            {
+                _cellStart[c] += _cellStart[c - 1];
+            }
+            _items.resize(_cellStart.back());
+        }
+        else
+        {
+            //the second pass moved every start to the start of the next cell
+            for (size_t c = _cellStart.size() - 1; c > 0; --c)
+            {
+                _cellStart[c] = _cellStart[c - 1];
+            }
+            _cellStart[0] = 0;
+        }
+    }
+}
+
+bool PolygonIndex::cellOf(const sf::Vector2f& point, size_t& cell) const
+{
+    if (_columns == 0
+        || point.x < _bounds.left || point.x > _bounds.left + _bounds.width
+        || point.y < _bounds.top || point.y > _bounds.top + _bounds.height)
+    {
+        return false;
+    }
+    size_t c = std::min(_columns - 1, static_cast<size_t>((point.x - _bounds.left) * _invCellWidth));
+    size_t r = std::min(_rows - 1, static_cast<size_t>((point.y - _bounds.top) * _invCellHeight));
+    cell = r * _columns + c;
+    return true;
+}
+
+int PolygonIndex::find(const sf::Vector2f& point) const
+{
+    size_t cell;
+    if (!cellOf(point, cell))
+    {
+        return -1;
+    }
+    for (uint32_t i = _cellStart[cell]; i < _cellStart[cell + 1]; ++i)
+    {
+        if (_polygons[_items[i]].contains(point))
+        {
+            return static_cast<int>(_items[i]);
+        }
+    }
+    return -1;
+}
+
+void PolygonIndex::findAll(const sf::Vector2f& point, std::vector<size_t>& result) const
+{
+    size_t cell;
+    if (!cellOf(point, cell))
+    {
+        return;
+    }
+    for (uint32_t i = _cellStart[cell]; i < _cellStart[cell + 1]; ++i)
+    {
+        if (_polygons[_items[i]].contains(point))
+        {
+            result.push_back(_items[i]);
+        }
+    }
+}
+
+size_t PolygonIndex::memoryUsage() const
+{
+    size_t bytes = sizeof(*this)
+        + _polygons.capacity() * sizeof(ConvexPolygon)
+        + _cellStart.capacity() * sizeof(uint32_t)
+        + _items.capacity() * sizeof(uint32_t);
+    for (size_t i = 0; i < _polygons.size(); ++i)
+    {
+        bytes += _polygons[i].memoryUsage();
+    }
+    return bytes;
+}
+
+} // !namespace inclusion
@@ -0,0 +1,74 @@
+#ifndef INCLUSION_POLYGONINDEX_HPP
+#define INCLUSION_POLYGONINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "convexpolygon.hpp"
+
+namespace inclusion
+{
+
+//static uniform grid over the bounds of many convex polygons
+//every cell lists the polygons whose bounds overlap it, all the lists are stored
+//one after the other in a single array, so a query reads one contiguous range
+//and only runs the exact test on the polygons of the cell of the point
+class PolygonIndex
+{
+    public:
+
+        PolygonIndex();
+
+        //bulk loads the polygons, replacing the previous ones
+        //cellsPerPolygon is the average number of cells per polygon, 0 picks about one
+        void build(const std::vector<ConvexPolygon>& polygons, float cellsPerPolygon = 0.0f);
+
+        //index of the polygon that contains point, the lowest one if several do
+        //returns -1 if none does
+        int find(const sf::Vector2f& point) const;
+
+        //appends the indices of all the polygons that contain point, in increasing order
+        void findAll(const sf::Vector2f& point, std::vector<size_t>& result) const;
+
+        const std::vector<ConvexPolygon>& getPolygons() const
+        {
+            return _polygons;
+        }
+
+        size_t getColumns() const
+        {
+            return _columns;
+        }
+
+        size_t getRows() const
+        {
+            return _rows;
+        }
+
+        //bytes allocated by the index and the polygons it holds
+        size_t memoryUsage() const;
+
+    private:
+
+        //returns false if point is outside of the grid
+        bool cellOf(const sf::Vector2f& point, size_t& cell) const;
+
+        std::vector<ConvexPolygon> _polygons;
+
+        //polygons of cell c are _items[_cellStart[c]] to _items[_cellStart[c+1]-1]
+        std::vector<uint32_t> _cellStart;
+        std::vector<uint32_t> _items;
+
+        sf::FloatRect _bounds;
+        size_t _columns;
+        size_t _rows;
+        float _invCellWidth;
+        float _invCellHeight;
+};
+
+} // !namespace inclusion
+
+#endif // INCLUSION_POLYGONINDEX_HPP
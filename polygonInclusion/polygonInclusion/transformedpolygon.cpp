@@ -0,0 +1,48 @@
+#include "transformedpolygon.hpp"
+
+#include <vector>
+
+namespace inclusion
+{
+
+TransformedPolygon::TransformedPolygon() : _rotation(0.0f), _dirty(true)
+{
+}
+
+TransformedPolygon::TransformedPolygon(const sf::Shape& shape) : _rotation(0.0f), _dirty(true)
+{
+    setGeometry(shape);
+    update(shape);
+}
+
+void TransformedPolygon::setGeometry(const sf::Shape& shape)
+{
+    std::vector<sf::Vector2f> points(shape.getPointCount());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        points[i] = shape.getPoint(i);
+    }
+    _local.setPoints(points);
+}
+
+bool TransformedPolygon::update(const sf::Transformable& shape)
+{
+    if (!_dirty
+        && shape.getPosition() == _position
+        && shape.getRotation() == _rotation
+        && shape.getScale() == _scale
+        && shape.getOrigin() == _origin)
+    {
+        return false;
+    }
+
+    _position = shape.getPosition();
+    _rotation = shape.getRotation();
+    _scale = shape.getScale();
+    _origin = shape.getOrigin();
+    _inverse = shape.getInverseTransform();
+    _dirty = false;
+    return true;
+}
+
+} // !namespace inclusion
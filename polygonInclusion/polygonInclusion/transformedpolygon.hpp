@@ -0,0 +1,61 @@
+#ifndef INCLUSION_TRANSFORMEDPOLYGON_HPP
+#define INCLUSION_TRANSFORMEDPOLYGON_HPP
+
+#include <SFML/Graphics.hpp>
+
+#include "polygon.hpp"
+
+namespace inclusion
+{
+
+//polygon prepared in the local space of a shape, concave ones included
+//the local points are prepared once, and queries map the point through the inverse
+//transform of the shape instead of transforming every vertex. The inverse is only
+//copied again when the position, rotation, scale or origin of the shape change
+class TransformedPolygon
+{
+    public:
+
+        TransformedPolygon();
+
+        explicit TransformedPolygon(const sf::Shape& shape);
+
+        //reads the local points of shape, call it again if they change
+        void setGeometry(const sf::Shape& shape);
+
+        //caches the inverse transform of shape if it moved since the last update
+        //returns true if it did
+        bool update(const sf::Transformable& shape);
+
+        //point is in world space
+        bool contains(const sf::Vector2f& point) const
+        {
+            return _local.contains(_inverse.transformPoint(point));
+        }
+
+        const Polygon& getLocalPolygon() const
+        {
+            return _local;
+        }
+
+        const sf::Transform& getInverseTransform() const
+        {
+            return _inverse;
+        }
+
+    private:
+
+        Polygon _local;
+        sf::Transform _inverse;
+
+        //transform the inverse was taken from
+        sf::Vector2f _position;
+        sf::Vector2f _scale;
+        sf::Vector2f _origin;
+        float _rotation;
+        bool _dirty;
+};
+
+} // !namespace inclusion
+
+#endif // INCLUSION_TRANSFORMEDPOLYGON_HPP
@@ -0,0 +1,155 @@
+#include "walkingquery.hpp"
+
+#include <algorithm>
+
+#include "inclusion.hpp"
+
+namespace inclusion
+{
+
+WalkingQuery::WalkingQuery(const ConvexPolygon& polygon) : _polygon(&polygon), _rising(0), _falling(0), _valid(false), _steps(0)
+{
+}
+
+void WalkingQuery::reset()
+{
+    _valid = false;
+}
+
+const sf::Vector2f& WalkingQuery::start(size_t chainStart, size_t k) const
+{
+    const std::vector<sf::Vector2f>& points = _polygon->getPoints();
+    return points[(chainStart + k) % points.size()];
+}
+
+const sf::Vector2f& WalkingQuery::end(size_t chainStart, size_t k) const
+{
+    const std::vector<sf::Vector2f>& points = _polygon->getPoints();
+    return points[(chainStart + k + 1) % points.size()];
+}
+
+bool WalkingQuery::contains(const sf::Vector2f& point)
+{
+    _steps = 0;
+    const sf::FloatRect& bounds = _polygon->getBounds();
+    if (_polygon->getRisingCount() == 0 || _polygon->getFallingCount() == 0
+        || point.y < bounds.top || point.y > bounds.top + bounds.height)
+    {
+        return false;
+    }
+
+    if (_valid)
+    {
+        walkRising(point.y);
+        walkFalling(point.y);
+    }
+    else
+    {
+        searchRising(point.y, 0, _polygon->getRisingCount() - 1);
+        searchFalling(point.y, 0, _polygon->getFallingCount() - 1);
+        _valid = true;
+    }
+
+    //both edges cross the horizontal line of the point, which is inside if it is
+    //on their inner side, like for every edge of ConvexPolygon::contains
+    const size_t rs = _polygon->getRisingStart();
+    const size_t fs = _polygon->getFallingStart();
+    const sf::Vector2f& ra = start(rs, _rising);
+    const sf::Vector2f& fa = start(fs, _falling);
+    return orientation(ra, end(rs, _rising), point) >= 0
+        && orientation(fa, end(fs, _falling), point) >= 0;
+}
+
+void WalkingQuery::walkRising(float y)
+{
+    //gallops away from the last edge with doubling strides, then searches between
+    //the last two strides, so a move across d edges costs about 2*log2(d) tests
+    const size_t rs = _polygon->getRisingStart();
+    const size_t count = _polygon->getRisingCount();
+    size_t bound = 1;
+    if (y < start(rs, _rising).y)
+    {
+        while (bound <= _rising && end(rs, _rising - bound).y >= y)
+        {
+            ++_steps;
+            bound *= 2;
+        }
+        searchRising(y, bound <= _rising ? _rising - bound + 1 : 0, _rising - bound / 2);
+    }
+    else if (y > end(rs, _rising).y)
+    {
+        while (_rising + bound < count && end(rs, _rising + bound).y < y)
+        {
+            ++_steps;
+            bound *= 2;
+        }
+        searchRising(y, _rising + bound / 2 + 1, std::min(_rising + bound, count - 1));
+    }
+}
+
+void WalkingQuery::walkFalling(float y)
+{
+    const size_t fs = _polygon->getFallingStart();
+    const size_t count = _polygon->getFallingCount();
+    size_t bound = 1;
+    if (y > start(fs, _falling).y)
+    {
+        while (bound <= _falling && end(fs, _falling - bound).y <= y)
+        {
+            ++_steps;
+            bound *= 2;
+        }
+        searchFalling(y, bound <= _falling ? _falling - bound + 1 : 0, _falling - bound / 2);
+    }
+    else if (y < end(fs, _falling).y)
+    {
+        while (_falling + bound < count && end(fs, _falling + bound).y > y)
+        {
+            ++_steps;
+            bound *= 2;
+        }
+        searchFalling(y, _falling + bound / 2 + 1, std::min(_falling + bound, count - 1));
+    }
+}
+
+void WalkingQuery::searchRising(float y, size_t lo, size_t hi)
+{
+    //first edge of the chain that ends at or above y
+    const size_t rs = _polygon->getRisingStart();
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        ++_steps;
+        if (end(rs, mid).y >= y)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    _rising = lo;
+}
+
+void WalkingQuery::searchFalling(float y, size_t lo, size_t hi)
+{
+    //first edge of the chain that ends at or below y
+    const size_t fs = _polygon->getFallingStart();
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        ++_steps;
+        if (end(fs, mid).y <= y)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    _falling = lo;
+}
+
+} // !namespace inclusion
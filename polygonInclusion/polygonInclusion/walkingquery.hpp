@@ -0,0 +1,59 @@
+#ifndef INCLUSION_WALKINGQUERY_HPP
+#define INCLUSION_WALKINGQUERY_HPP
+
+#include <cstddef>
+
+#include <SFML/Graphics.hpp>
+
+#include "convexpolygon.hpp"
+
+namespace inclusion
+{
+
+//containment handle for a point that moves a little between two queries
+//it keeps the edges of the rising and falling chains of the polygon that bracket
+//the y of the last point, and walks from them to the ones of the new point
+//smooth motion only tests a few edges, and a jump is found by galloping from the
+//last edges, never costing much more than a binary search over the chains
+//the polygon must outlive the handle, call reset() if its points change
+class WalkingQuery
+{
+    public:
+
+        explicit WalkingQuery(const ConvexPolygon& polygon);
+
+        //forgets the last edges, the next query starts with a binary search
+        void reset();
+
+        //same result as ConvexPolygon::contains
+        bool contains(const sf::Vector2f& point);
+
+        //edges visited by the last query, walking or searching
+        size_t getLastSteps() const
+        {
+            return _steps;
+        }
+
+    private:
+
+        //moves along a chain from the last edge to the one that brackets y
+        void walkRising(float y);
+        void walkFalling(float y);
+
+        //binary search of the bracketing edge between the indices lo and hi of a chain
+        void searchRising(float y, size_t lo, size_t hi);
+        void searchFalling(float y, size_t lo, size_t hi);
+
+        const sf::Vector2f& start(size_t chainStart, size_t k) const;
+        const sf::Vector2f& end(size_t chainStart, size_t k) const;
+
+        const ConvexPolygon* _polygon;
+        size_t _rising;
+        size_t _falling;
+        bool _valid;
+        size_t _steps;
+};
+
+} // !namespace inclusion
+
+#endif // INCLUSION_WALKINGQUERY_HPP